@@ -0,0 +1,135 @@
+/* OpenGL Information Query Library - extension lookup microbenchmark
+**
+** Copyrights (c) 2021-2023 by Trinh D.D. Nguyen <dzutrinh[]yahoo.com>
+** All Rights Reserved
+** 
+** Redistribution and use in source and binary forms, with or without 
+** modification, are permitted provided that the following conditions are met:
+** 
+** * Redistributions of source code must retain the above copyright notice, 
+**   this list of conditions and the following disclaimer.
+** * Redistributions in binary form must reproduce the above copyright notice, 
+**   this list of conditions and the following disclaimer in the documentation 
+**   and/or other materials provided with the distribution.
+** * The name of the author may be used to endorse or promote products 
+**   derived from this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE 
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF 
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+** THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/* 
+** Compares the hashed extension index against the linear checkExtension() scan on a 
+** synthetic 600 extensions list, looking up 150 names the way a renderer bootstrap does.
+** The library source is included directly to reach its internal lookup routines.
+**
+** $make bench && bin/extlookup
+*/
+
+#include "../src/ogli.c"
+#include <time.h>
+
+#define BENCH_EXTENSIONS    600
+#define BENCH_LOOKUPS       150
+#define BENCH_ROUNDS        2000
+
+static const char * vendors[] = {"ARB", "EXT", "KHR", "NV", "AMD", "INTEL", "MESA", "OES", "NVX", "ATI"};
+static const char * features[] = {"texture_compression", "shader_atomic_counters", "draw_indirect", 
+                                  "framebuffer_object", "sparse_buffer", "gpu_shader_int64", 
+                                  "multi_draw", "bindless_texture", "clip_control", "robustness"};
+
+static double benchNow(void)
+{
+#ifdef _WIN32
+    LARGE_INTEGER freq, now;
+    QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&now);
+    return (double) now.QuadPart / (double) freq.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+#endif
+}
+
+int main(void)
+{
+    static char     extList[BENCH_EXTENSIONS * 48];
+    static char     names[BENCH_LOOKUPS][48];
+    const char      * lookups[BENCH_LOOKUPS];
+    GLboolean       results[BENCH_LOOKUPS];
+    OGLI_CONTEXT    * ctx;
+    GLuint          idx, round, hitsScan = 0, hitsIndex = 0, hitsBatch = 0;
+    char            * tail = extList;
+    double          start, build, scan, hashed, batch;
+
+    /* synthesize a driver-like extension string */
+    for (idx = 0; idx < BENCH_EXTENSIONS; idx++)
+        tail += sprintf(tail, "GL_%s_%s_%u ", vendors[idx % 10], features[(idx / 10) % 10], idx);
+
+    /* two thirds of the lookups hit, the rest miss */
+    for (idx = 0; idx < BENCH_LOOKUPS; idx++)
+    {
+        if (idx % 3)
+            sprintf(names[idx], "GL_%s_%s_%u", vendors[(idx * 4) % 10], features[((idx * 4) / 10) % 10], idx * 4);
+        else
+            sprintf(names[idx], "GL_%s_%s_%u", vendors[idx % 10], features[idx % 10], BENCH_EXTENSIONS + idx);
+        lookups[idx] = names[idx];
+    }
+
+    /* no rendering context is needed, the index is built straight from the string */
+    ctx = ogliInit(OGLI_LEGACY);
+    if (!ctx)
+        return -1;
+
+    start = benchNow();
+    for (round = 0; round < BENCH_ROUNDS; round++)
+    {
+        ogliExtListParse(&ctx->iblock.glExtensions, extList);
+        ogliIndexBuild(&ctx->extIndex, &ctx->iblock.glExtensions);
+    }
+    build = (benchNow() - start) / BENCH_ROUNDS;
+
+    start = benchNow();
+    for (round = 0; round < BENCH_ROUNDS; round++)
+        for (idx = 0; idx < BENCH_LOOKUPS; idx++)
+            hitsScan += checkExtension(extList, lookups[idx]);
+    scan = (benchNow() - start) / BENCH_ROUNDS;
+
+    start = benchNow();
+    for (round = 0; round < BENCH_ROUNDS; round++)
+        for (idx = 0; idx < BENCH_LOOKUPS; idx++)
+            hitsIndex += ogliSupported(ctx, lookups[idx]);
+    hashed = (benchNow() - start) / BENCH_ROUNDS;
+
+    start = benchNow();
+    for (round = 0; round < BENCH_ROUNDS; round++)
+        hitsBatch += ogliSupportedMany(ctx, lookups, BENCH_LOOKUPS, results);
+    batch = (benchNow() - start) / BENCH_ROUNDS;
+
+    if (hitsScan != hitsIndex || hitsScan != hitsBatch)
+    {
+        fprintf(stderr, "ERROR: lookup results differ (%u, %u, %u)\n", hitsScan, hitsIndex, hitsBatch);
+        return -1;
+    }
+
+    printf("Extension lookup benchmark: %u extensions (%u bytes), %u lookups\n", 
+           ctx->extIndex.count, (GLuint) strlen(extList), BENCH_LOOKUPS);
+    printf(" . checkExtension    : %10.2f us\n", scan * 1e6);
+    printf(" . list + index build: %10.2f us\n", build * 1e6);
+    printf(" . ogliSupported     : %10.2f us\n", hashed * 1e6);
+    printf(" . ogliSupportedMany : %10.2f us (%u supported)\n", batch * 1e6, hitsBatch / BENCH_ROUNDS);
+    printf(" . speedup           : %10.1fx (%.1fx including build)\n", scan / hashed, scan / (hashed + build));
+
+    ogliShutdown(ctx);
+    return 0;
+}
@@ -0,0 +1,172 @@
+/* OpenGL Information Query Library - query daemon latency benchmark
+**
+** Copyrights (c) 2021-2023 by Trinh D.D. Nguyen <dzutrinh[]yahoo.com>
+** All Rights Reserved
+** 
+** Redistribution and use in source and binary forms, with or without 
+** modification, are permitted provided that the following conditions are met:
+** 
+** * Redistributions of source code must retain the above copyright notice, 
+**   this list of conditions and the following disclaimer.
+** * Redistributions in binary form must reproduce the above copyright notice, 
+**   this list of conditions and the following disclaimer in the documentation 
+**   and/or other materials provided with the distribution.
+** * The name of the author may be used to endorse or promote products 
+**   derived from this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE 
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF 
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+** THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/* 
+** Drives a running query daemon (glinfo --serve) from several concurrent clients, each
+** one sending extension checks and waiting for the answer, and reports the round trip
+** latency percentiles. Linux only, like the daemon.
+**
+** $bin/glinfo --serve /tmp/glinfo.sock & make bench && bin/servelat /tmp/glinfo.sock
+*/
+
+#include <errno.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#define BENCH_CLIENTS       8
+#define BENCH_QUERIES       5000
+
+static const char * request = "ext GL_ARB_multisample GL_ARB_vertex_buffer_object GL_NV_no_such_extension";
+
+typedef struct bench_client
+{
+    const char  * path;
+    double      latencies[BENCH_QUERIES];
+    int         failed;
+} BENCH_CLIENT;
+
+static double benchNow(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static int benchTransfer(int fd, char * data, size_t length, int sending)
+{
+    ssize_t done;
+
+    while (length)
+    {
+        done = sending ? send(fd, data, length, MSG_NOSIGNAL) : recv(fd, data, length, 0);
+        if (done < 0 && errno == EINTR)
+            continue;
+        if (done <= 0)
+            return 0;
+        data += done;
+        length -= done;
+    }
+    return 1;
+}
+
+static void * benchClient(void * arg)
+{
+    BENCH_CLIENT        * client = (BENCH_CLIENT *) arg;
+    struct sockaddr_un  addr;
+    char                frame[256], answer[256];
+    uint32_t            length = (uint32_t) strlen(request), size = htonl(length);
+    double              start;
+    int                 fd, idx;
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strncpy(addr.sun_path, client->path, sizeof(addr.sun_path) - 1);
+    memcpy(frame, &size, 4);
+    memcpy(frame + 4, request, length);
+
+    client->failed = 1;
+    fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0 || connect(fd, (struct sockaddr *) &addr, sizeof(addr)) < 0)
+        return NULL;
+
+    for (idx = 0; idx < BENCH_QUERIES; idx++)
+    {
+        start = benchNow();
+        if (!benchTransfer(fd, frame, 4 + length, 1) || !benchTransfer(fd, (char *) &size, 4, 0))
+            break;
+        size = ntohl(size);
+        if (size >= sizeof(answer) || !benchTransfer(fd, answer, size, 0) || strncmp(answer, "OK 1 1 0", size) != 0)
+            break;
+        client->latencies[idx] = benchNow() - start;
+        size = htonl(length);
+    }
+    client->failed = idx != BENCH_QUERIES;
+    close(fd);
+    return NULL;
+}
+
+static int benchCompare(const void * a, const void * b)
+{
+    double x = *(const double *) a, y = *(const double *) b;
+    return (x > y) - (x < y);
+}
+
+int main(int argc, char ** argv)
+{
+    static BENCH_CLIENT clients[BENCH_CLIENTS];
+    static double       all[BENCH_CLIENTS * BENCH_QUERIES];
+    pthread_t           threads[BENCH_CLIENTS];
+    double              start, elapsed, total = 0;
+    int                 idx, count = BENCH_CLIENTS * BENCH_QUERIES;
+
+    if (argc < 2)
+    {
+        fprintf(stderr, "Usage: servelat socket\n");
+        return -1;
+    }
+
+    start = benchNow();
+    for (idx = 0; idx < BENCH_CLIENTS; idx++)
+    {
+        clients[idx].path = argv[1];
+        pthread_create(&threads[idx], NULL, benchClient, &clients[idx]);
+    }
+    for (idx = 0; idx < BENCH_CLIENTS; idx++)
+        pthread_join(threads[idx], NULL);
+    elapsed = benchNow() - start;
+
+    for (idx = 0; idx < BENCH_CLIENTS; idx++)
+    {
+        if (clients[idx].failed)
+        {
+            fprintf(stderr, "ERROR: client %d failed, is the daemon running on %s?\n", idx, argv[1]);
+            return -1;
+        }
+        memcpy(all + idx * BENCH_QUERIES, clients[idx].latencies, sizeof(clients[idx].latencies));
+    }
+
+    qsort(all, count, sizeof(double), benchCompare);
+    for (idx = 0; idx < count; idx++)
+        total += all[idx];
+
+    printf("Query daemon benchmark: %d clients, %d extension checks each\n", BENCH_CLIENTS, BENCH_QUERIES);
+    printf(" . mean       : %10.2f us\n", total / count * 1e6);
+    printf(" . p50        : %10.2f us\n", all[count / 2] * 1e6);
+    printf(" . p99        : %10.2f us\n", all[count * 99 / 100] * 1e6);
+    printf(" . throughput : %10.0f queries/s\n", count / elapsed);
+    return 0;
+}
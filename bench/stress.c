@@ -0,0 +1,181 @@
+/* OpenGL Information Query Library - concurrent pipeline stress test
+**
+** Copyrights (c) 2021-2023 by Trinh D.D. Nguyen <dzutrinh[]yahoo.com>
+** All Rights Reserved
+** 
+** Redistribution and use in source and binary forms, with or without 
+** modification, are permitted provided that the following conditions are met:
+** 
+** * Redistributions of source code must retain the above copyright notice, 
+**   this list of conditions and the following disclaimer.
+** * Redistributions in binary form must reproduce the above copyright notice, 
+**   this list of conditions and the following disclaimer in the documentation 
+**   and/or other materials provided with the distribution.
+** * The name of the author may be used to endorse or promote products 
+**   derived from this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE 
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF 
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+** THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/* 
+** Runs the init -> create -> query -> destroy -> shutdown pipeline from many threads at the
+** same time, cycling through the profiles, and checks every result against a reference 
+** taken on a single thread first. Any crash, X error leaking to another context or mixed up
+** entry point shows up as a failure or a mismatch.
+**
+** $make bench && bin/stress [threads] [rounds] [egl]
+*/
+
+#include "../src/ogli.h"
+#include <stdio.h>
+#ifndef _WIN32
+#   include <pthread.h>
+#endif
+
+#define STRESS_THREADS      16
+#define STRESS_ROUNDS       8
+
+typedef struct stress_result
+{
+    GLboolean   valid;
+    char        renderer[OGLI_MAX_INFO_LENGTH];
+    char        version[OGLI_MAX_INFO_LENGTH];
+    GLuint      extensions;
+    GLuint      limits;
+} STRESS_RESULT;
+
+typedef struct stress_thread
+{
+    GLuint      index;
+    GLuint      runs;
+    GLuint      unavailable;    /* profile could not be created, as in the reference */
+    GLuint      failures;       /* pipeline failed where the reference succeeded */
+    GLuint      mismatches;     /* results differ from the reference */
+} STRESS_THREAD;
+
+static STRESS_RESULT    reference[OGLI_TOTAL_PROFILES];
+static OGLI_BACKEND     backend = OGLI_BACKEND_NATIVE;
+static GLuint           rounds = STRESS_ROUNDS;
+
+static GLboolean stressRun(OGLI_PROFILE profile, STRESS_RESULT * result)
+{
+    OGLI_CONTEXT * ctx = ogliInit(profile);
+
+    memset(result, 0, sizeof(STRESS_RESULT));
+    if (!ctx)
+        return GL_FALSE;
+
+    if (ogliSetBackend(ctx, backend) && ogliCreateContext(ctx))
+    {
+        result->valid = ogliQuery(ctx);
+        strcpy(result->renderer, ctx->iblock.glRenderer);
+        strcpy(result->version, ctx->iblock.glVersion);
+        result->extensions = ctx->iblock.totalExtensions;
+        result->limits = ctx->iblock.totalLimits;
+        result->valid = ogliDestroyContext(ctx) && result->valid;
+    }
+    ogliShutdown(ctx);
+    return result->valid;
+}
+
+#ifdef _WIN32
+static DWORD WINAPI stressThread(LPVOID arg)
+#else
+static void * stressThread(void * arg)
+#endif
+{
+    STRESS_THREAD   * thread = (STRESS_THREAD *) arg;
+    STRESS_RESULT   result;
+    OGLI_PROFILE    profile;
+    GLuint          round;
+
+    for (round = 0; round < rounds; round++)
+    {
+        profile = (OGLI_PROFILE) ((thread->index + round) % OGLI_TOTAL_PROFILES);
+        thread->runs++;
+        if (!stressRun(profile, &result))
+        {
+            if (reference[profile].valid)
+                thread->failures++;
+            else
+                thread->unavailable++;
+        }
+        else if (!reference[profile].valid || strcmp(result.renderer, reference[profile].renderer) || 
+                 strcmp(result.version, reference[profile].version) ||
+                 result.extensions != reference[profile].extensions || result.limits != reference[profile].limits)
+            thread->mismatches++;
+    }
+    return 0;
+}
+
+int main(int argc, char ** argv)
+{
+    static STRESS_THREAD    threads[256];
+    GLuint                  count = STRESS_THREADS, idx, runs = 0, unavailable = 0, failures = 0, mismatches = 0;
+    double                  start, elapsed;
+#ifdef _WIN32
+    HANDLE                  handles[256];
+#else
+    pthread_t               handles[256];
+#endif
+
+    if (argc > 1)
+        count = (GLuint) atoi(argv[1]);
+    if (argc > 2)
+        rounds = (GLuint) atoi(argv[2]);
+    if (argc > 3 && strcmp(argv[3], "egl") == 0)
+        backend = OGLI_BACKEND_EGL;
+    if (count < 1 || count > 256 || rounds < 1)
+    {
+        fprintf(stderr, "Usage: stress [threads (1-256)] [rounds] [egl]\n");
+        return -1;
+    }
+
+    for (idx = 0; idx < OGLI_TOTAL_PROFILES; idx++)
+        stressRun((OGLI_PROFILE) idx, &reference[idx]);
+
+    start = ogliNow();
+    for (idx = 0; idx < count; idx++)
+    {
+        threads[idx].index = idx;
+#ifdef _WIN32
+        handles[idx] = CreateThread(NULL, 0, stressThread, &threads[idx], 0, NULL);
+#else
+        pthread_create(&handles[idx], NULL, stressThread, &threads[idx]);
+#endif
+    }
+    for (idx = 0; idx < count; idx++)
+    {
+#ifdef _WIN32
+        WaitForSingleObject(handles[idx], INFINITE);
+        CloseHandle(handles[idx]);
+#else
+        pthread_join(handles[idx], NULL);
+#endif
+        runs += threads[idx].runs;
+        unavailable += threads[idx].unavailable;
+        failures += threads[idx].failures;
+        mismatches += threads[idx].mismatches;
+    }
+    elapsed = ogliNow() - start;
+
+    printf("Concurrent pipeline stress test: %u threads, %u rounds each\n", count, rounds);
+    for (idx = 0; idx < OGLI_TOTAL_PROFILES; idx++)
+        printf(" . %-11s : %s\n", ogliProfileName((OGLI_PROFILE) idx), 
+               reference[idx].valid ? reference[idx].version : "not available");
+    printf(" . runs        : %u in %.2f s (%.1f pipelines/s)\n", runs, elapsed, runs / elapsed);
+    printf(" . unavailable : %u\n", unavailable);
+    printf(" . failures    : %u\n", failures);
+    printf(" . mismatches  : %u\n", mismatches);
+    return failures || mismatches ? -1 : 0;
+}
@@ -0,0 +1,91 @@
+/* OpenGL Information Query Library - in-process query example
+**
+** Copyrights (c) 2021-2023 by Trinh D.D. Nguyen <dzutrinh[]yahoo.com>
+** All Rights Reserved
+** 
+** Redistribution and use in source and binary forms, with or without 
+** modification, are permitted provided that the following conditions are met:
+** 
+** * Redistributions of source code must retain the above copyright notice, 
+**   this list of conditions and the following disclaimer.
+** * Redistributions in binary form must reproduce the above copyright notice, 
+**   this list of conditions and the following disclaimer in the documentation 
+**   and/or other materials provided with the distribution.
+** * The name of the author may be used to endorse or promote products 
+**   derived from this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE 
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF 
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+** THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/* 
+** Checks at startup what a renderer needs, in-process through libogli: no glinfo process
+** to spawn and no output to parse.
+**
+** $make examples && bin/query [egl]
+** $cc query.c $(pkg-config --cflags --libs ogli)
+*/
+
+#include <stdio.h>
+#include "ogli.h"
+
+static const char * required[] = {"GL_ARB_vertex_buffer_object", "GL_ARB_framebuffer_object", 
+                                  "GL_ARB_uniform_buffer_object", "GL_ARB_compute_shader"};
+
+#define REQUIRED_COUNT  (sizeof(required) / sizeof(required[0]))
+
+int main(int argc, char ** argv)
+{
+    OGLI_CONTEXT        * ctx;
+    const OGLI_LIMIT    * limit;
+    GLboolean           supported[REQUIRED_COUNT];
+    GLuint              idx, count;
+
+    /* a library built from another major version has another context layout */
+    if ((ogliGetVersion() >> 8) != OGLI_MAJOR_VERSION)
+    {
+        fprintf(stderr, "ERROR: libogli %u.%u is not compatible with this program.\n", 
+                ogliGetVersion() >> 8, ogliGetVersion() & 0xFF);
+        return -1;
+    }
+
+    ctx = ogliInit(OGLI_CORE);
+    if (!ctx)
+        return -1;
+    if (argc > 1 && strcmp(argv[1], "egl") == 0 && !ogliSetBackend(ctx, OGLI_BACKEND_EGL))
+        fprintf(stderr, "WARNING: EGL backend is not available, using the native one.\n");
+
+    /* limits bring the extensions along, GLU is not needed */
+    if (!ogliCreateContext(ctx) || !ogliQueryEx(ctx, OGLI_Q_LIMITS))
+    {
+        fprintf(stderr, "ERROR: Unable to query OpenGL.\n");
+        ogliShutdown(ctx);
+        return -1;
+    }
+
+    /* the results outlive the rendering context */
+    ogliDestroyContext(ctx);
+
+    printf("Renderer : %s\n", ctx->iblock.glRenderer);
+    printf("Version  : %s\n", ctx->iblock.glVersion);
+
+    count = ogliSupportedMany(ctx, required, REQUIRED_COUNT, supported);
+    for (idx = 0; idx < REQUIRED_COUNT; idx++)
+        printf("%-28s : %s\n", required[idx], supported[idx] ? "yes" : "no");
+
+    limit = ogliGetLimit(ctx, "GL_MAX_TEXTURE_SIZE");
+    if (limit)
+        printf("%-28s : %lld\n", "GL_MAX_TEXTURE_SIZE", (long long) limit->values[0]);
+
+    ogliShutdown(ctx);
+    return count == REQUIRED_COUNT ? 0 : 1;
+}
@@ -0,0 +1,121 @@
+/* OpenGL Information Query Library - GPU timer example
+**
+** Copyrights (c) 2021-2023 by Trinh D.D. Nguyen <dzutrinh[]yahoo.com>
+** All Rights Reserved
+** 
+** Redistribution and use in source and binary forms, with or without 
+** modification, are permitted provided that the following conditions are met:
+** 
+** * Redistributions of source code must retain the above copyright notice, 
+**   this list of conditions and the following disclaimer.
+** * Redistributions in binary form must reproduce the above copyright notice, 
+**   this list of conditions and the following disclaimer in the documentation 
+**   and/or other materials provided with the distribution.
+** * The name of the author may be used to endorse or promote products 
+**   derived from this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE 
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF 
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+** THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/* 
+** Times texture uploads frame by frame without stalling: each result is picked up a few
+** frames later, once the GPU is done with it.
+**
+** $make examples && bin/timer [egl]
+** $cc timer.c $(pkg-config --cflags --libs ogli) -lGL
+*/
+
+#include <stdio.h>
+#include "ogli.h"
+
+#define FRAMES      (24)
+#define TEX_SIZE    (1024)
+
+static const char * modes[] = {"CPU (submission only)", "GL_TIMESTAMP", "GL_TIME_ELAPSED"};
+
+/* frame of each measurement in flight, by ring slot */
+static GLuint frames[OGLI_TIMER_RING];
+
+static void report(OGLI_TIMER * timer)
+{
+    double start, elapsed;
+    GLuint frame = frames[timer->read % OGLI_TIMER_RING];
+
+    while (ogliTimerRead(timer, &start, &elapsed))
+    {
+        printf("frame %2u : %8.3f ms at %.6f s\n", frame, elapsed * 1e3, start);
+        frame = frames[timer->read % OGLI_TIMER_RING];
+    }
+}
+
+int main(int argc, char ** argv)
+{
+    OGLI_CONTEXT    * ctx;
+    OGLI_TIMER      * timer;
+    GLubyte         * pixels;
+    GLuint          texture, idx;
+
+    if ((ogliGetVersion() >> 8) != OGLI_MAJOR_VERSION)
+    {
+        fprintf(stderr, "ERROR: libogli %u.%u is not compatible with this program.\n", 
+                ogliGetVersion() >> 8, ogliGetVersion() & 0xFF);
+        return -1;
+    }
+
+    ctx = ogliInit(OGLI_LEGACY);
+    if (!ctx)
+        return -1;
+    if (argc > 1 && strcmp(argv[1], "egl") == 0 && !ogliSetBackend(ctx, OGLI_BACKEND_EGL))
+        fprintf(stderr, "WARNING: EGL backend is not available, using the native one.\n");
+
+    pixels = (GLubyte *) calloc(TEX_SIZE * TEX_SIZE, 4);
+    if (!pixels || !ogliCreateContext(ctx) || !ogliQueryEx(ctx, OGLI_Q_BASIC) || !(timer = ogliTimerCreate(ctx)))
+    {
+        fprintf(stderr, "ERROR: Unable to set up OpenGL.\n");
+        free(pixels);
+        ogliShutdown(ctx);
+        return -1;
+    }
+
+    ogliTimerCalibrate(timer);
+    printf("Renderer   : %s\n", ctx->iblock.glRenderer);
+    printf("Timer      : %s\n", modes[timer->mode]);
+    printf("Resolution : %.3f us\n", timer->resolution * 1e6);
+    printf("Offset     : %+.3f ms\n", timer->offset * 1e3);
+
+    glGenTextures(1, &texture);
+    glBindTexture(GL_TEXTURE_2D, texture);
+    for (idx = 0; idx < FRAMES; idx++)
+    {
+        /* a full ring means the oldest result is still in flight, skip timing this frame */
+        report(timer);
+        pixels[0] = (GLubyte) idx;
+        frames[timer->issued % OGLI_TIMER_RING] = idx;
+        if (ogliTimerBegin(timer))
+        {
+            glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, TEX_SIZE, TEX_SIZE, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+            ogliTimerEnd(timer);
+        }
+        else
+            glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, TEX_SIZE, TEX_SIZE, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+    }
+
+    glFinish();
+    report(timer);
+
+    glDeleteTextures(1, &texture);
+    ogliTimerDestroy(timer);
+    free(pixels);
+    ogliShutdown(ctx);
+    return 0;
+}
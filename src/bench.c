@@ -0,0 +1,976 @@
+/* OpenGL Information Query Utility - Benchmarks
+**
+** Copyrights (c) 2021-2023 by Trinh D.D. Nguyen <dzutrinh[]yahoo.com>
+** All Rights Reserved
+** 
+** Redistribution and use in source and binary forms, with or without 
+** modification, are permitted provided that the following conditions are met:
+** 
+** * Redistributions of source code must retain the above copyright notice, 
+**   this list of conditions and the following disclaimer.
+** * Redistributions in binary form must reproduce the above copyright notice, 
+**   this list of conditions and the following disclaimer in the documentation 
+**   and/or other materials provided with the distribution.
+** * The name of the author may be used to endorse or promote products 
+**   derived from this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE 
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF 
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+** THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <stddef.h>
+#include <stdio.h>
+#ifdef __linux__
+#   include <dirent.h>
+#endif
+#include "bench.h"
+
+/* tokens beyond OpenGL 1.1 */
+#define GL_ARRAY_BUFFER             0x8892
+#define GL_STATIC_DRAW              0x88E4
+#define GL_FRAGMENT_SHADER          0x8B30
+#define GL_VERTEX_SHADER            0x8B31
+#define GL_COMPILE_STATUS           0x8B81
+#define GL_LINK_STATUS              0x8B82
+#define GL_FRAMEBUFFER_COMPLETE     0x8CD5
+#define GL_COLOR_ATTACHMENT0        0x8CE0
+#define GL_FRAMEBUFFER              0x8D40
+#define GL_RENDERBUFFER             0x8D41
+#define GL_PROGRAM_BINARY_RETRIEVABLE_HINT  0x8257
+#define GL_PROGRAM_BINARY_LENGTH    0x8741
+#define GL_NUM_PROGRAM_BINARY_FORMATS       0x87FE
+#define GL_MAX_SHADER_COMPILER_THREADS_KHR  0x91B0
+#define GL_COMPLETION_STATUS_KHR    0x91B1
+
+/* entry points of OpenGL 3.0, under private names to work with every header set */
+typedef void    (APIENTRY * BENCH_GEN_PROC)(GLsizei n, GLuint * names);
+typedef void    (APIENTRY * BENCH_DELETE_PROC)(GLsizei n, const GLuint * names);
+typedef void    (APIENTRY * BENCH_BIND_PROC)(GLenum target, GLuint name);
+typedef void    (APIENTRY * BENCH_NAME_PROC)(GLuint name);
+typedef void    (APIENTRY * BENCH_FBRENDERBUFFER_PROC)(GLenum target, GLenum attachment, GLenum rbtarget, GLuint rb);
+typedef GLenum  (APIENTRY * BENCH_FBSTATUS_PROC)(GLenum target);
+typedef void    (APIENTRY * BENCH_RBSTORAGE_PROC)(GLenum target, GLenum format, GLsizei width, GLsizei height);
+typedef void    (APIENTRY * BENCH_BUFFERDATA_PROC)(GLenum target, ptrdiff_t size, const void * data, GLenum usage);
+typedef void    (APIENTRY * BENCH_ATTRIBPOINTER_PROC)(GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const void * pointer);
+typedef GLuint  (APIENTRY * BENCH_CREATESHADER_PROC)(GLenum type);
+typedef void    (APIENTRY * BENCH_SHADERSOURCE_PROC)(GLuint shader, GLsizei count, const char * const * source, const GLint * length);
+typedef void    (APIENTRY * BENCH_GETIV_PROC)(GLuint name, GLenum pname, GLint * param);
+typedef GLuint  (APIENTRY * BENCH_CREATEPROGRAM_PROC)(void);
+typedef void    (APIENTRY * BENCH_ATTACHSHADER_PROC)(GLuint program, GLuint shader);
+typedef void    (APIENTRY * BENCH_BINDATTRIB_PROC)(GLuint program, GLuint index, const char * name);
+typedef GLint   (APIENTRY * BENCH_UNIFORMLOC_PROC)(GLuint program, const char * name);
+typedef void    (APIENTRY * BENCH_UNIFORM4F_PROC)(GLint location, GLfloat x, GLfloat y, GLfloat z, GLfloat w);
+typedef void    (APIENTRY * BENCH_GETBINARY_PROC)(GLuint program, GLsizei size, GLsizei * length, GLenum * format, void * binary);
+typedef void    (APIENTRY * BENCH_PROGRAMBINARY_PROC)(GLuint program, GLenum format, const void * binary, GLsizei length);
+typedef void    (APIENTRY * BENCH_PROGRAMPARAM_PROC)(GLuint program, GLenum pname, GLint value);
+typedef void    (APIENTRY * BENCH_THREADS_PROC)(GLuint count);
+
+typedef struct bench_gl
+{
+    BENCH_GEN_PROC              genFramebuffers, genRenderbuffers, genBuffers, genVertexArrays;
+    BENCH_DELETE_PROC           deleteFramebuffers, deleteRenderbuffers, deleteBuffers, deleteVertexArrays;
+    BENCH_BIND_PROC             bindFramebuffer, bindRenderbuffer, bindBuffer;
+    BENCH_NAME_PROC             bindVertexArray, enableVertexAttribArray, compileShader, deleteShader;
+    BENCH_NAME_PROC             linkProgram, useProgram, deleteProgram;
+    BENCH_FBRENDERBUFFER_PROC   framebufferRenderbuffer;
+    BENCH_FBSTATUS_PROC         checkFramebufferStatus;
+    BENCH_RBSTORAGE_PROC        renderbufferStorage;
+    BENCH_BUFFERDATA_PROC       bufferData;
+    BENCH_ATTRIBPOINTER_PROC    vertexAttribPointer;
+    BENCH_CREATESHADER_PROC     createShader;
+    BENCH_SHADERSOURCE_PROC     shaderSource;
+    BENCH_GETIV_PROC            getShaderiv, getProgramiv;
+    BENCH_CREATEPROGRAM_PROC    createProgram;
+    BENCH_ATTACHSHADER_PROC     attachShader;
+    BENCH_BINDATTRIB_PROC       bindAttribLocation;
+    BENCH_UNIFORMLOC_PROC       getUniformLocation;
+    BENCH_UNIFORM4F_PROC        uniform4f;
+    BENCH_GETBINARY_PROC        getProgramBinary;       /* optional, program binaries */
+    BENCH_PROGRAMBINARY_PROC    programBinary;
+    BENCH_PROGRAMPARAM_PROC     programParameteri;
+    BENCH_THREADS_PROC          maxShaderCompilerThreads;   /* optional, parallel compilation */
+} BENCH_GL;
+
+/* objects of a raster benchmark run */
+typedef struct bench_raster_objects
+{
+    GLuint  fbo, rbo, vbo, vao, program;
+} BENCH_OBJECTS;
+
+#define BENCH_MIN_TIME      (0.1)       /* shortest measured run, in seconds */
+#define BENCH_MAX_DRAWS     (1 << 16)   /* draw calls cap of a measured run */
+#define BENCH_FILL_LAYERS   (8)         /* full screen quads per fill rate draw */
+#define BENCH_SMALL_GRID    (256)       /* small triangles per row, 2 pixels each */
+#define BENCH_LARGE_GRID    (8)         /* large triangles per row, 8192 pixels each */
+
+#define BENCH_FILL_VERTS    (BENCH_FILL_LAYERS * 6)
+#define BENCH_SMALL_VERTS   (BENCH_SMALL_GRID * BENCH_SMALL_GRID * 3)
+#define BENCH_LARGE_VERTS   (BENCH_LARGE_GRID * BENCH_LARGE_GRID * 3)
+
+static const char * benchVertexShader =
+    "in vec2 pos;\n"
+    "void main() { gl_Position = vec4(pos, 0.0, 1.0); }\n";
+
+static const char * benchFragmentShader =
+    "uniform vec4 color;\n"
+    "out vec4 frag;\n"
+    "void main() { frag = color; }\n";
+
+static OGLI_PROC benchProc(const OGLI_CONTEXT * ctx, const char * name, GLuint * missing)
+{
+    OGLI_PROC proc = ogliGetProc(ctx, name);
+
+    if (!proc)
+        (*missing)++;
+    return proc;
+}
+
+static GLboolean benchLoad(const OGLI_CONTEXT * ctx, BENCH_GL * gl)
+{
+    GLuint missing = 0;
+
+    gl->genFramebuffers         = (BENCH_GEN_PROC) benchProc(ctx, "glGenFramebuffers", &missing);
+    gl->genRenderbuffers        = (BENCH_GEN_PROC) benchProc(ctx, "glGenRenderbuffers", &missing);
+    gl->genBuffers              = (BENCH_GEN_PROC) benchProc(ctx, "glGenBuffers", &missing);
+    gl->genVertexArrays         = (BENCH_GEN_PROC) benchProc(ctx, "glGenVertexArrays", &missing);
+    gl->deleteFramebuffers      = (BENCH_DELETE_PROC) benchProc(ctx, "glDeleteFramebuffers", &missing);
+    gl->deleteRenderbuffers     = (BENCH_DELETE_PROC) benchProc(ctx, "glDeleteRenderbuffers", &missing);
+    gl->deleteBuffers           = (BENCH_DELETE_PROC) benchProc(ctx, "glDeleteBuffers", &missing);
+    gl->deleteVertexArrays      = (BENCH_DELETE_PROC) benchProc(ctx, "glDeleteVertexArrays", &missing);
+    gl->bindFramebuffer         = (BENCH_BIND_PROC) benchProc(ctx, "glBindFramebuffer", &missing);
+    gl->bindRenderbuffer        = (BENCH_BIND_PROC) benchProc(ctx, "glBindRenderbuffer", &missing);
+    gl->bindBuffer              = (BENCH_BIND_PROC) benchProc(ctx, "glBindBuffer", &missing);
+    gl->bindVertexArray         = (BENCH_NAME_PROC) benchProc(ctx, "glBindVertexArray", &missing);
+    gl->enableVertexAttribArray = (BENCH_NAME_PROC) benchProc(ctx, "glEnableVertexAttribArray", &missing);
+    gl->compileShader           = (BENCH_NAME_PROC) benchProc(ctx, "glCompileShader", &missing);
+    gl->deleteShader            = (BENCH_NAME_PROC) benchProc(ctx, "glDeleteShader", &missing);
+    gl->linkProgram             = (BENCH_NAME_PROC) benchProc(ctx, "glLinkProgram", &missing);
+    gl->useProgram              = (BENCH_NAME_PROC) benchProc(ctx, "glUseProgram", &missing);
+    gl->deleteProgram           = (BENCH_NAME_PROC) benchProc(ctx, "glDeleteProgram", &missing);
+    gl->framebufferRenderbuffer = (BENCH_FBRENDERBUFFER_PROC) benchProc(ctx, "glFramebufferRenderbuffer", &missing);
+    gl->checkFramebufferStatus  = (BENCH_FBSTATUS_PROC) benchProc(ctx, "glCheckFramebufferStatus", &missing);
+    gl->renderbufferStorage     = (BENCH_RBSTORAGE_PROC) benchProc(ctx, "glRenderbufferStorage", &missing);
+    gl->bufferData              = (BENCH_BUFFERDATA_PROC) benchProc(ctx, "glBufferData", &missing);
+    gl->vertexAttribPointer     = (BENCH_ATTRIBPOINTER_PROC) benchProc(ctx, "glVertexAttribPointer", &missing);
+    gl->createShader            = (BENCH_CREATESHADER_PROC) benchProc(ctx, "glCreateShader", &missing);
+    gl->shaderSource            = (BENCH_SHADERSOURCE_PROC) benchProc(ctx, "glShaderSource", &missing);
+    gl->getShaderiv             = (BENCH_GETIV_PROC) benchProc(ctx, "glGetShaderiv", &missing);
+    gl->getProgramiv            = (BENCH_GETIV_PROC) benchProc(ctx, "glGetProgramiv", &missing);
+    gl->createProgram           = (BENCH_CREATEPROGRAM_PROC) benchProc(ctx, "glCreateProgram", &missing);
+    gl->attachShader            = (BENCH_ATTACHSHADER_PROC) benchProc(ctx, "glAttachShader", &missing);
+    gl->bindAttribLocation      = (BENCH_BINDATTRIB_PROC) benchProc(ctx, "glBindAttribLocation", &missing);
+    gl->getUniformLocation      = (BENCH_UNIFORMLOC_PROC) benchProc(ctx, "glGetUniformLocation", &missing);
+    gl->uniform4f               = (BENCH_UNIFORM4F_PROC) benchProc(ctx, "glUniform4f", &missing);
+
+    return missing == 0;
+}
+
+static GLuint benchShader(const BENCH_GL * gl, GLenum type, const char * header, const char * body)
+{
+    const char  * source[2] = {header, body};
+    GLuint      shader = gl->createShader(type);
+    GLint       done = 0;
+
+    gl->shaderSource(shader, 2, source, NULL);
+    gl->compileShader(shader);
+    gl->getShaderiv(shader, GL_COMPILE_STATUS, &done);
+    if (!done)
+    {
+        gl->deleteShader(shader);
+        return 0;
+    }
+    return shader;
+}
+
+/* GLSL 1.50 is the only version core contexts of OSX accept, 1.30 covers OpenGL 3.0 and 3.1 */
+static GLuint benchProgram(const OGLI_CONTEXT * ctx, const BENCH_GL * gl)
+{
+    const char  * header;
+    GLuint      vs, fs, program;
+    GLint       done = 0;
+
+    header = ctx->iblock.versionGL.major > 3 || ctx->iblock.versionGL.minor >= 2 ? "#version 150\n" : "#version 130\n";
+    vs = benchShader(gl, GL_VERTEX_SHADER, header, benchVertexShader);
+    fs = benchShader(gl, GL_FRAGMENT_SHADER, header, benchFragmentShader);
+    if (!vs || !fs)
+    {
+        if (vs) gl->deleteShader(vs);
+        if (fs) gl->deleteShader(fs);
+        return 0;
+    }
+
+    program = gl->createProgram();
+    gl->attachShader(program, vs);
+    gl->attachShader(program, fs);
+    gl->bindAttribLocation(program, 0, "pos");
+    gl->linkProgram(program);
+    gl->deleteShader(vs);
+    gl->deleteShader(fs);
+    gl->getProgramiv(program, GL_LINK_STATUS, &done);
+    if (!done)
+    {
+        gl->deleteProgram(program);
+        return 0;
+    }
+    return program;
+}
+
+/* appends a grid of right triangles with legs of 'leg' pixels, one per cell */
+static GLfloat * benchGrid(GLfloat * out, GLuint cells, GLuint leg)
+{
+    GLfloat cell = 2.0f / cells, size = 2.0f * leg / GLINFO_BENCH_SIZE, x, y;
+    GLuint  row, col;
+
+    for (row = 0; row < cells; row++)
+    {
+        for (col = 0; col < cells; col++)
+        {
+            x = -1.0f + col * cell;
+            y = -1.0f + row * cell;
+            *out++ = x;         *out++ = y;
+            *out++ = x + size;  *out++ = y;
+            *out++ = x;         *out++ = y + size;
+        }
+    }
+    return out;
+}
+
+/* fills the vertex buffer with the fill, small and large triangle sets, in that order */
+static GLboolean benchGeometry(const BENCH_GL * gl)
+{
+    static const GLfloat quad[12] = {-1, -1,  1, -1, -1,  1,  1, -1,  1,  1, -1,  1};
+    GLfloat * vertices, * out;
+    GLuint  idx;
+
+    vertices = (GLfloat *) malloc((BENCH_FILL_VERTS + BENCH_SMALL_VERTS + BENCH_LARGE_VERTS) * 2 * sizeof(GLfloat));
+    if (!vertices)
+        return GL_FALSE;
+
+    for (idx = 0, out = vertices; idx < BENCH_FILL_LAYERS; idx++, out += 12)
+        memcpy(out, quad, sizeof(quad));
+    out = benchGrid(out, BENCH_SMALL_GRID, 2);
+    benchGrid(out, BENCH_LARGE_GRID, 128);
+
+    gl->bufferData(GL_ARRAY_BUFFER, (BENCH_FILL_VERTS + BENCH_SMALL_VERTS + BENCH_LARGE_VERTS) * 2 * sizeof(GLfloat),
+                   vertices, GL_STATIC_DRAW);
+    free(vertices);
+    return GL_TRUE;
+}
+
+/* doubles the number of draws until the run is long enough to be measured, returns draws per second */
+static double benchDraws(GLint first, GLsizei count)
+{
+    GLuint  draws, idx;
+    double  start, elapsed;
+
+    glDrawArrays(GL_TRIANGLES, first, count);   /* warm up, shaders may be compiled lazily */
+    glFinish();
+
+    for (draws = 1; ; draws *= 2)
+    {
+        start = ogliNow();
+        for (idx = 0; idx < draws; idx++)
+            glDrawArrays(GL_TRIANGLES, first, count);
+        glFinish();
+        elapsed = ogliNow() - start;
+        if (elapsed >= BENCH_MIN_TIME || draws >= BENCH_MAX_DRAWS)
+            return elapsed > 0 ? draws / elapsed : 0;
+    }
+}
+
+static void benchRelease(const BENCH_GL * gl, BENCH_OBJECTS * obj)
+{
+    gl->useProgram(0);
+    gl->bindVertexArray(0);
+    gl->bindBuffer(GL_ARRAY_BUFFER, 0);
+    gl->bindFramebuffer(GL_FRAMEBUFFER, 0);
+
+    if (obj->program)   gl->deleteProgram(obj->program);
+    if (obj->vao)       gl->deleteVertexArrays(1, &obj->vao);
+    if (obj->vbo)       gl->deleteBuffers(1, &obj->vbo);
+    if (obj->rbo)       gl->deleteRenderbuffers(1, &obj->rbo);
+    if (obj->fbo)       gl->deleteFramebuffers(1, &obj->fbo);
+}
+
+const char * benchRaster(OGLI_CONTEXT * ctx, GLINFO_RASTER_BENCH * result)
+{
+    const double    pixels = (double) GLINFO_BENCH_SIZE * GLINFO_BENCH_SIZE;
+    BENCH_OBJECTS   obj;
+    BENCH_GL        gl;
+    GLint           color;
+
+    memset(result, 0, sizeof(GLINFO_RASTER_BENCH));
+    if (!ctx || !ctx->active)
+        return "No active OpenGL context.";
+    if (ctx->iblock.versionGL.major < 3)
+        return "Raster benchmark requires OpenGL 3.0.";
+    if (!benchLoad(ctx, &gl))
+        return "Raster benchmark entry points are missing.";
+
+    while (glGetError() != GL_NO_ERROR);
+    memset(&obj, 0, sizeof(BENCH_OBJECTS));
+
+    /* offscreen target, the default framebuffer may be a 1x1 pbuffer or none at all */
+    gl.genFramebuffers(1, &obj.fbo);
+    gl.genRenderbuffers(1, &obj.rbo);
+    gl.bindFramebuffer(GL_FRAMEBUFFER, obj.fbo);
+    gl.bindRenderbuffer(GL_RENDERBUFFER, obj.rbo);
+    gl.renderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, GLINFO_BENCH_SIZE, GLINFO_BENCH_SIZE);
+    gl.framebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, obj.rbo);
+    if (gl.checkFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+    {
+        benchRelease(&gl, &obj);
+        return "Offscreen framebuffer is incomplete.";
+    }
+
+    obj.program = benchProgram(ctx, &gl);
+    if (!obj.program)
+    {
+        benchRelease(&gl, &obj);
+        return "Raster benchmark shaders cannot be built.";
+    }
+
+    gl.genVertexArrays(1, &obj.vao);
+    gl.genBuffers(1, &obj.vbo);
+    gl.bindVertexArray(obj.vao);
+    gl.bindBuffer(GL_ARRAY_BUFFER, obj.vbo);
+    if (!benchGeometry(&gl))
+    {
+        benchRelease(&gl, &obj);
+        return "Out of memory.";
+    }
+    gl.enableVertexAttribArray(0);
+    gl.vertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 0, NULL);
+
+    gl.useProgram(obj.program);
+    color = gl.getUniformLocation(obj.program, "color");
+    gl.uniform4f(color, 1.0f, 0.5f, 0.25f, 0.5f);
+    glViewport(0, 0, GLINFO_BENCH_SIZE, GLINFO_BENCH_SIZE);
+    glDisable(GL_DEPTH_TEST);
+    glDisable(GL_CULL_FACE);
+    glClear(GL_COLOR_BUFFER_BIT);
+
+    glDisable(GL_BLEND);
+    result->fillOpaque = benchDraws(0, BENCH_FILL_VERTS) * BENCH_FILL_LAYERS * pixels / 1e6;
+    result->trisSmall = benchDraws(BENCH_FILL_VERTS, BENCH_SMALL_VERTS) * (BENCH_SMALL_VERTS / 3) / 1e6;
+    result->trisLarge = benchDraws(BENCH_FILL_VERTS + BENCH_SMALL_VERTS, BENCH_LARGE_VERTS) * (BENCH_LARGE_VERTS / 3) / 1e6;
+
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    result->fillBlended = benchDraws(0, BENCH_FILL_VERTS) * BENCH_FILL_LAYERS * pixels / 1e6;
+    glDisable(GL_BLEND);
+
+    benchRelease(&gl, &obj);
+    if (glGetError() != GL_NO_ERROR)
+    {
+        memset(result, 0, sizeof(GLINFO_RASTER_BENCH));
+        return "OpenGL error during the raster benchmark.";
+    }
+    return NULL;
+}
+
+/*------------------------------------------------------------------------------------------------*/
+/*                                      Shader benchmark                                          */
+/*------------------------------------------------------------------------------------------------*/
+
+#define BENCH_SHADER_RUNS       (32)        /* builds of each program at most */
+#define BENCH_SHADER_MIN_RUNS   (8)         /* builds of each program at least */
+#define BENCH_SHADER_BUDGET     (1.0)       /* seconds per program once the minimum is reached */
+#define BENCH_SHADER_BATCH      (16)        /* programs of a throughput run */
+#define BENCH_UBER_LAYERS       (48)        /* material layers of the uber-shader */
+#define BENCH_SALT_SIZE         (64)
+
+/* one program of the corpus */
+typedef struct bench_source
+{
+    const char  * name;
+    const char  * vertex;
+    const char  * fragment;
+} BENCH_SOURCE;
+
+static const char * benchTrivialFS =
+    "uniform vec4 color;\n"
+    "out vec4 frag;\n"
+    "void main() { frag = color + salt; }\n";
+
+static const char * benchLitVS =
+    "in vec2 pos;\n"
+    "uniform mat4 mvp;\n"
+    "uniform mat3 normalMatrix;\n"
+    "out vec3 normal;\n"
+    "out vec3 tangent;\n"
+    "out vec3 world;\n"
+    "out vec2 uv;\n"
+    "void main()\n"
+    "{\n"
+    "    vec4 p = vec4(pos, salt, 1.0);\n"
+    "    world = p.xyz;\n"
+    "    normal = normalize(normalMatrix * vec3(0.0, 0.0, 1.0));\n"
+    "    tangent = normalize(normalMatrix * vec3(1.0, 0.0, 0.0));\n"
+    "    uv = pos * 0.5 + 0.5;\n"
+    "    gl_Position = mvp * p;\n"
+    "}\n";
+
+/* textured Blinn-Phong with 4 point lights */
+static const char * benchLitFS =
+    "uniform sampler2D albedo;\n"
+    "uniform vec3 lightPos[4];\n"
+    "uniform vec3 lightColor[4];\n"
+    "uniform vec3 eye;\n"
+    "in vec3 normal;\n"
+    "in vec3 world;\n"
+    "in vec2 uv;\n"
+    "out vec4 frag;\n"
+    "void main()\n"
+    "{\n"
+    "    vec3 base = texture(albedo, uv).rgb, n = normalize(normal), v = normalize(eye - world);\n"
+    "    vec3 c = base * 0.05 + salt;\n"
+    "    for (int i = 0; i < 4; i++)\n"
+    "    {\n"
+    "        vec3 l = lightPos[i] - world;\n"
+    "        float d = length(l);\n"
+    "        l /= d;\n"
+    "        float atten = 1.0 / (1.0 + 0.1 * d + 0.01 * d * d);\n"
+    "        c += atten * lightColor[i] * (base * max(dot(n, l), 0.0) + pow(max(dot(n, normalize(l + v)), 0.0), 32.0));\n"
+    "    }\n"
+    "    frag = vec4(c, 1.0);\n"
+    "}\n";
+
+/* Cook-Torrance with normal mapping, 8 point lights, 5x5 PCF shadows and tone mapping */
+static const char * benchPbrFS =
+    "uniform sampler2D albedoMap, normalMap, roughnessMap, shadowMap;\n"
+    "uniform samplerCube irradiance;\n"
+    "uniform vec3 lightPos[8];\n"
+    "uniform vec3 lightColor[8];\n"
+    "uniform vec3 eye;\n"
+    "uniform mat4 shadowMatrix;\n"
+    "uniform float exposure;\n"
+    "in vec3 normal;\n"
+    "in vec3 tangent;\n"
+    "in vec3 world;\n"
+    "in vec2 uv;\n"
+    "out vec4 frag;\n"
+    "const float PI = 3.14159265;\n"
+    "float distributionGGX(float nh, float r)\n"
+    "{\n"
+    "    float a2 = r * r * r * r, d = nh * nh * (a2 - 1.0) + 1.0;\n"
+    "    return a2 / (PI * d * d);\n"
+    "}\n"
+    "float geometrySmith(float nv, float nl, float r)\n"
+    "{\n"
+    "    float k = (r + 1.0) * (r + 1.0) / 8.0;\n"
+    "    return nv / (nv * (1.0 - k) + k) * nl / (nl * (1.0 - k) + k);\n"
+    "}\n"
+    "vec3 fresnelSchlick(float c, vec3 f0)\n"
+    "{\n"
+    "    return f0 + (1.0 - f0) * pow(1.0 - c, 5.0);\n"
+    "}\n"
+    "float shadow(vec3 p)\n"
+    "{\n"
+    "    vec4 s = shadowMatrix * vec4(p, 1.0);\n"
+    "    vec2 texel = 1.0 / vec2(textureSize(shadowMap, 0));\n"
+    "    float lit = 0.0;\n"
+    "    for (int y = -2; y <= 2; y++)\n"
+    "        for (int x = -2; x <= 2; x++)\n"
+    "            lit += s.z - 0.005 > texture(shadowMap, s.xy + vec2(x, y) * texel).r ? 0.0 : 1.0;\n"
+    "    return lit / 25.0;\n"
+    "}\n"
+    "void main()\n"
+    "{\n"
+    "    vec3 t = normalize(tangent), n0 = normalize(normal);\n"
+    "    vec3 n = normalize(mat3(t, cross(n0, t), n0) * (texture(normalMap, uv).xyz * 2.0 - 1.0));\n"
+    "    vec3 albedo = pow(texture(albedoMap, uv).rgb, vec3(2.2));\n"
+    "    vec2 rm = texture(roughnessMap, uv).gb;\n"
+    "    vec3 v = normalize(eye - world), f0 = mix(vec3(0.04), albedo, rm.y), lo = vec3(salt);\n"
+    "    float nv = max(dot(n, v), 0.001);\n"
+    "    for (int i = 0; i < 8; i++)\n"
+    "    {\n"
+    "        vec3 l = lightPos[i] - world;\n"
+    "        float d = length(l);\n"
+    "        l /= d;\n"
+    "        float nl = max(dot(n, l), 0.0);\n"
+    "        vec3 f = fresnelSchlick(max(dot(normalize(v + l), v), 0.0), f0);\n"
+    "        vec3 spec = distributionGGX(max(dot(n, normalize(v + l)), 0.0), rm.x) * geometrySmith(nv, nl, rm.x) * f / (4.0 * nv * nl + 0.001);\n"
+    "        lo += ((1.0 - f) * (1.0 - rm.y) * albedo / PI + spec) * lightColor[i] * nl / (d * d);\n"
+    "    }\n"
+    "    vec3 c = lo * shadow(world) + texture(irradiance, n).rgb * albedo * 0.03;\n"
+    "    c = vec3(1.0) - exp(-c * exposure);\n"
+    "    frag = vec4(pow(c, vec3(1.0 / 2.2)), 1.0);\n"
+    "}\n";
+
+/* the uber-shader chains material layers, each one a function the compiler inlines */
+static char * benchUberFS()
+{
+    const size_t    size = 1024 + BENCH_UBER_LAYERS * 512;
+    char            * text = (char *) malloc(size);
+    size_t          used;
+    GLuint          idx;
+
+    if (!text)
+        return NULL;
+
+    used = snprintf(text, size, "uniform sampler2D maps[8];\n"
+                                "uniform vec4 params[%d];\n"
+                                "uniform int mode;\n"
+                                "in vec3 normal;\n"
+                                "in vec3 world;\n"
+                                "in vec2 uv;\n"
+                                "out vec4 frag;\n", BENCH_UBER_LAYERS);
+    for (idx = 0; idx < BENCH_UBER_LAYERS; idx++)
+        used += snprintf(text + used, size - used, "vec3 layer%u(vec3 c, vec2 st, vec3 n)\n"
+                                                   "{\n"
+                                                   "    vec4 p = params[%u];\n"
+                                                   "    float w = sin(st.x * %u.0 + p.x) * cos(st.y * %u.0 + p.y);\n"
+                                                   "    vec3 t = texture(maps[%u], st * p.zw + w).rgb;\n"
+                                                   "    if ((mode & %u) != 0)\n"
+                                                   "        c = mix(c, t * w, p.y);\n"
+                                                   "    else\n"
+                                                   "        c += pow(max(dot(n, normalize(vec3(%u.0, 1.0, 2.0))), 0.0), %u.0) * t;\n"
+                                                   "    return c;\n"
+                                                   "}\n",
+                         idx, idx, idx + 1, idx + 2, idx % 8, 1u << (idx % 16), idx + 1, 2 * (idx % 8) + 2);
+    used += snprintf(text + used, size - used, "void main()\n"
+                                               "{\n"
+                                               "    vec3 c = vec3(salt), n = normalize(normal);\n");
+    for (idx = 0; idx < BENCH_UBER_LAYERS; idx++)
+        used += snprintf(text + used, size - used, "    c = layer%u(c, uv, n);\n", idx);
+    snprintf(text + used, size - used, "    frag = vec4(c, 1.0);\n"
+                                       "}\n");
+    return text;
+}
+
+/* a constant unique to each build, so that no driver cache, in memory or on disk, can answer */
+static void benchSalt(char * salt, GLuint value)
+{
+    snprintf(salt, BENCH_SALT_SIZE, "const float salt = %u.0 * 1e-12;\n", value);
+}
+
+static GLuint benchStage(const BENCH_GL * gl, GLenum type, const char * header, const char * salt, const char * body)
+{
+    const char  * source[3] = {header, salt, body};
+    GLuint      shader = gl->createShader(type);
+
+    gl->shaderSource(shader, 3, source, NULL);
+    gl->compileShader(shader);
+    return shader;
+}
+
+/* compiles and links a salted copy of a program, the status queries wait for the driver */
+static GLuint benchBuild(const BENCH_GL * gl, const char * header, const BENCH_SOURCE * source, GLuint salt,
+                         GLboolean retrievable, double * compile, double * link)
+{
+    char    text[BENCH_SALT_SIZE];
+    GLuint  vs, fs, program;
+    GLint   vsDone = 0, fsDone = 0, done = 0;
+    double  start;
+
+    benchSalt(text, salt);
+    start = ogliNow();
+    vs = benchStage(gl, GL_VERTEX_SHADER, header, text, source->vertex);
+    fs = benchStage(gl, GL_FRAGMENT_SHADER, header, text, source->fragment);
+    gl->getShaderiv(vs, GL_COMPILE_STATUS, &vsDone);
+    gl->getShaderiv(fs, GL_COMPILE_STATUS, &fsDone);
+    *compile = ogliNow() - start;
+
+    start = ogliNow();
+    program = gl->createProgram();
+    gl->attachShader(program, vs);
+    gl->attachShader(program, fs);
+    gl->bindAttribLocation(program, 0, "pos");
+    if (retrievable)
+        gl->programParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    gl->linkProgram(program);
+    gl->getProgramiv(program, GL_LINK_STATUS, &done);
+    *link = ogliNow() - start;
+
+    gl->deleteShader(vs);
+    gl->deleteShader(fs);
+    if (!vsDone || !fsDone || !done)
+    {
+        gl->deleteProgram(program);
+        return 0;
+    }
+    return program;
+}
+
+/* reloads a linked program from its binary, as a startup with a warm program cache would */
+static GLboolean benchReload(const BENCH_GL * gl, GLuint program, double * reload, GLuint * size)
+{
+    GLint   length = 0, done = 0;
+    GLenum  format = 0;
+    GLuint  copy;
+    void    * binary;
+    double  start;
+
+    gl->getProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0)
+        return GL_FALSE;
+    binary = malloc(length);
+    if (!binary)
+        return GL_FALSE;
+    gl->getProgramBinary(program, length, &length, &format, binary);
+
+    start = ogliNow();
+    copy = gl->createProgram();
+    gl->programBinary(copy, format, binary, length);
+    gl->getProgramiv(copy, GL_LINK_STATUS, &done);
+    *reload = ogliNow() - start;
+
+    gl->deleteProgram(copy);
+    free(binary);
+    *size = length;
+    return done != 0;
+}
+
+static int benchCompareTimes(const void * a, const void * b)
+{
+    double x = *(const double *) a, y = *(const double *) b;
+
+    return x < y ? -1 : x > y;
+}
+
+/* nearest rank percentile of sorted durations, in milliseconds */
+static double benchPercentile(const double * sorted, GLuint count, GLuint percent)
+{
+    GLuint rank = (count * percent + 99) / 100;
+
+    return sorted[rank ? rank - 1 : 0] * 1e3;
+}
+
+static void benchLatencies(double * samples, GLuint count, double * result)
+{
+    qsort(samples, count, sizeof(double), benchCompareTimes);
+    result[0] = benchPercentile(samples, count, 50);
+    result[1] = benchPercentile(samples, count, 99);
+}
+
+/* builds a batch of the corpus, with parallel compilation every program is in flight before any is checked */
+static double benchBatch(const BENCH_GL * gl, const char * header, const BENCH_SOURCE * sources, GLuint * salt,
+                         GLboolean parallel)
+{
+    char    text[BENCH_SALT_SIZE];
+    GLuint  programs[BENCH_SHADER_BATCH], vs, fs, idx, pending, built = 0;
+    GLint   done;
+    double  start = ogliNow(), elapsed;
+
+    for (idx = 0; idx < BENCH_SHADER_BATCH; idx++)
+    {
+        benchSalt(text, (*salt)++);
+        vs = benchStage(gl, GL_VERTEX_SHADER, header, text, sources[idx % GLINFO_SHADER_PROGRAMS].vertex);
+        fs = benchStage(gl, GL_FRAGMENT_SHADER, header, text, sources[idx % GLINFO_SHADER_PROGRAMS].fragment);
+        programs[idx] = gl->createProgram();
+        gl->attachShader(programs[idx], vs);
+        gl->attachShader(programs[idx], fs);
+        gl->bindAttribLocation(programs[idx], 0, "pos");
+        gl->linkProgram(programs[idx]);
+        gl->deleteShader(vs);
+        gl->deleteShader(fs);
+        if (!parallel)
+        {
+            done = 0;
+            gl->getProgramiv(programs[idx], GL_LINK_STATUS, &done);
+        }
+    }
+
+    /* GL_COMPLETION_STATUS_KHR never blocks, unlike GL_LINK_STATUS */
+    for (pending = parallel; pending; )
+    {
+        pending = 0;
+        for (idx = 0; idx < BENCH_SHADER_BATCH; idx++)
+        {
+            done = 0;
+            gl->getProgramiv(programs[idx], GL_COMPLETION_STATUS_KHR, &done);
+            if (!done)
+                pending++;
+        }
+    }
+
+    for (idx = 0; idx < BENCH_SHADER_BATCH; idx++)
+    {
+        done = 0;
+        gl->getProgramiv(programs[idx], GL_LINK_STATUS, &done);
+        if (done)
+            built++;
+    }
+    elapsed = ogliNow() - start;
+
+    for (idx = 0; idx < BENCH_SHADER_BATCH; idx++)
+        gl->deleteProgram(programs[idx]);
+    return built == BENCH_SHADER_BATCH && elapsed > 0 ? BENCH_SHADER_BATCH / elapsed : 0;
+}
+
+const char * benchShaders(OGLI_CONTEXT * ctx, GLINFO_SHADER_BENCH * result)
+{
+    static const char * names[GLINFO_SHADER_PROGRAMS] = {"trivial", "lit", "pbr", "uber"};
+    BENCH_SOURCE    sources[GLINFO_SHADER_PROGRAMS];
+    GLINFO_SHADER_PROGRAM * entry;
+    double          compile[BENCH_SHADER_RUNS], link[BENCH_SHADER_RUNS], reload[BENCH_SHADER_RUNS];
+    double          start, unused;
+    const char      * header, * error = NULL;
+    char            * uber;
+    GLuint          idx, run, program, salt = (GLuint) (ogliNow() * 1e3);
+    GLint           formats = 0, threads = 0;
+    BENCH_GL        gl;
+
+    memset(result, 0, sizeof(GLINFO_SHADER_BENCH));
+    if (!ctx || !ctx->active)
+        return "No active OpenGL context.";
+    if (ctx->iblock.versionGL.major < 3)
+        return "Shader benchmark requires OpenGL 3.0.";
+    if (!benchLoad(ctx, &gl))
+        return "Shader benchmark entry points are missing.";
+
+    /* optional features, both are core in recent versions but only trusted when advertised */
+    gl.getProgramBinary = (BENCH_GETBINARY_PROC) ogliGetProc(ctx, "glGetProgramBinary");
+    gl.programBinary = (BENCH_PROGRAMBINARY_PROC) ogliGetProc(ctx, "glProgramBinary");
+    gl.programParameteri = (BENCH_PROGRAMPARAM_PROC) ogliGetProc(ctx, "glProgramParameteri");
+    if (ogliSupported(ctx, "GL_KHR_parallel_shader_compile"))
+        gl.maxShaderCompilerThreads = (BENCH_THREADS_PROC) ogliGetProc(ctx, "glMaxShaderCompilerThreadsKHR");
+    else if (ogliSupported(ctx, "GL_ARB_parallel_shader_compile"))
+        gl.maxShaderCompilerThreads = (BENCH_THREADS_PROC) ogliGetProc(ctx, "glMaxShaderCompilerThreadsARB");
+
+    while (glGetError() != GL_NO_ERROR);
+    if (ogliSupported(ctx, "GL_ARB_get_program_binary") && gl.getProgramBinary && gl.programBinary && gl.programParameteri)
+    {
+        glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+        result->binary = formats > 0;
+    }
+    result->parallel = gl.maxShaderCompilerThreads != NULL;
+
+    uber = benchUberFS();
+    if (!uber)
+        return "Out of memory.";
+    header = ctx->iblock.versionGL.major > 3 || ctx->iblock.versionGL.minor >= 2 ? "#version 150\n" : "#version 130\n";
+    for (idx = 0; idx < GLINFO_SHADER_PROGRAMS; idx++)
+    {
+        sources[idx].name = names[idx];
+        sources[idx].vertex = idx ? benchLitVS : benchVertexShader;
+    }
+    sources[0].fragment = benchTrivialFS;
+    sources[1].fragment = benchLitFS;
+    sources[2].fragment = benchPbrFS;
+    sources[3].fragment = uber;
+
+    /* latencies are those of a single thread, the first build pays for the compiler setup */
+    if (result->parallel)
+        gl.maxShaderCompilerThreads(0);
+    program = benchBuild(&gl, header, &sources[0], salt++, GL_FALSE, &unused, &unused);
+    if (program)
+        gl.deleteProgram(program);
+    else
+        error = "Shader benchmark programs cannot be built.";
+
+    for (idx = 0; idx < GLINFO_SHADER_PROGRAMS && !error; idx++)
+    {
+        entry = &result->programs[idx];
+        entry->name = names[idx];
+        entry->sourceSize = (GLuint) (strlen(sources[idx].vertex) + strlen(sources[idx].fragment));
+        start = ogliNow();
+        for (run = 0; run < BENCH_SHADER_RUNS; run++)
+        {
+            if (run >= BENCH_SHADER_MIN_RUNS && ogliNow() - start > BENCH_SHADER_BUDGET)
+                break;
+            program = benchBuild(&gl, header, &sources[idx], salt++, result->binary, &compile[run], &link[run]);
+            if (!program)
+            {
+                error = "Shader benchmark programs cannot be built.";
+                break;
+            }
+            /* a driver may refuse its own binaries, reloads are then reported as unsupported */
+            if (result->binary && !benchReload(&gl, program, &reload[run], &entry->binarySize))
+                result->binary = GL_FALSE;
+            gl.deleteProgram(program);
+        }
+        entry->runs = run;
+        if (error)
+            break;
+        benchLatencies(compile, run, entry->compile);
+        benchLatencies(link, run, entry->link);
+        if (result->binary)
+            benchLatencies(reload, run, entry->reload);
+    }
+    for (idx = 0; idx < GLINFO_SHADER_PROGRAMS && !result->binary; idx++)
+    {
+        result->programs[idx].binarySize = 0;
+        result->programs[idx].reload[0] = result->programs[idx].reload[1] = 0;
+    }
+
+    if (!error)
+        result->serialRate = benchBatch(&gl, header, sources, &salt, GL_FALSE);
+    if (!error && result->parallel)
+    {
+        gl.maxShaderCompilerThreads(0xFFFFFFFF);
+        glGetIntegerv(GL_MAX_SHADER_COMPILER_THREADS_KHR, &threads);
+        result->threads = threads > 0 ? threads : 0;
+        result->parallelRate = benchBatch(&gl, header, sources, &salt, GL_TRUE);
+    }
+    free(uber);
+
+    if (!error && glGetError() != GL_NO_ERROR)
+        error = "OpenGL error during the shader benchmark.";
+    if (error)
+    {
+        memset(result, 0, sizeof(GLINFO_SHADER_BENCH));
+        return error;
+    }
+    return NULL;
+}
+
+#define BENCH_CHURN_WARMUP      (16)    /* contexts created before measuring, the pool fills up meanwhile */
+
+/* resident set in KB and open descriptors of the process, leaks show as steady growth */
+static GLboolean benchFootprint(long * rss, int * fds)
+{
+#ifdef __linux__
+    struct dirent   * entry;
+    FILE            * file;
+    DIR             * dir;
+    long            pages = 0;
+
+    file = fopen("/proc/self/statm", "r");
+    if (!file)
+        return GL_FALSE;
+    if (fscanf(file, "%*s %ld", &pages) != 1)
+        pages = 0;
+    fclose(file);
+    *rss = pages * (sysconf(_SC_PAGESIZE) / 1024);
+
+    dir = opendir("/proc/self/fd");
+    if (!dir)
+        return GL_FALSE;
+    for (*fds = 0; (entry = readdir(dir)) != NULL; )
+    {
+        if (entry->d_name[0] != '.')
+            (*fds)++;
+    }
+    closedir(dir);
+    return GL_TRUE;
+#else
+    *rss = 0;
+    *fds = 0;
+    return GL_FALSE;
+#endif
+}
+
+/* standalone contexts go through the whole pipeline, phases included */
+static GLboolean benchStandalone(const OGLI_CONTEXT * model, double * create, double * destroy, double * phases)
+{
+    const OGLI_TIMING   * timing;
+    OGLI_CONTEXT        * ctx;
+    double              start;
+    GLuint              idx;
+
+    start = ogliNow();
+    ctx = ogliInit(model->profile);
+    if (!ctx || !ogliSetBackend(ctx, model->backend) || !ogliSetWindowless(ctx, model->windowless) ||
+        !ogliSetTimings(ctx, phases != NULL) || !ogliCreateContext(ctx))
+    {
+        ogliShutdown(ctx);
+        return GL_FALSE;
+    }
+    *create = ogliNow() - start;
+
+    start = ogliNow();
+    ogliDestroyContext(ctx);
+    *destroy = ogliNow() - start;
+    if (phases)
+    {
+        timing = ogliGetTimings(ctx);
+        for (idx = 0; idx < OGLI_TOTAL_PHASES; idx++)
+            phases[idx] += timing[idx].duration;
+    }
+    ogliShutdown(ctx);
+    return GL_TRUE;
+}
+
+/* fresh contexts are destroyed on release once the pool holds OGLI_POOL_IDLE of them */
+static GLboolean benchPooled(OGLI_POOL * pool, OGLI_PROFILE profile, GLboolean fresh, double * create, double * destroy)
+{
+    OGLI_CONTEXT    * ctx;
+    double          start;
+
+    start = ogliNow();
+    ctx = ogliPoolAcquire(pool, profile, fresh);
+    if (!ctx)
+        return GL_FALSE;
+    *create = ogliNow() - start;
+
+    /* a context the pool could not take back is not left behind */
+    start = ogliNow();
+    if (!ogliPoolRelease(pool, ctx))
+    {
+        ogliShutdown(ctx);
+        return GL_FALSE;
+    }
+    *destroy = ogliNow() - start;
+    return GL_TRUE;
+}
+
+const char * benchChurn(const OGLI_CONTEXT * ctx, GLINFO_CHURN_BENCH * result)
+{
+    static const char * names[GLINFO_CHURN_MODES] = {"standalone", "pooled", "reused"};
+    GLINFO_CHURN_MODE   * mode;
+    OGLI_POOL           * pool = NULL;
+    double              create[GLINFO_CHURN_RUNS], destroy[GLINFO_CHURN_RUNS], unused, start;
+    long                rss[2];
+    int                 fds[2];
+    GLuint              idx, run;
+    GLboolean           done = GL_TRUE;
+
+    memset(result, 0, sizeof(GLINFO_CHURN_BENCH));
+    if (!ctx)
+        return "No OpenGL context to model the churn on.";
+
+    result->runs = GLINFO_CHURN_RUNS;
+    result->footprint = GL_TRUE;
+    for (idx = 0; idx < GLINFO_CHURN_MODES && done; idx++)
+    {
+        mode = &result->modes[idx];
+        mode->name = names[idx];
+        if (idx == 1)
+        {
+            pool = ogliPoolCreate(ctx->backend, ctx->windowless);
+            if (!pool)
+                return "Unable to create a context pool.";
+        }
+
+        /* the first contexts pay for loading the driver and filling the pool */
+        for (run = 0; run < BENCH_CHURN_WARMUP && done; run++)
+            done = idx ? benchPooled(pool, ctx->profile, idx == 1, &unused, &unused) :
+                         benchStandalone(ctx, &unused, &unused, NULL);
+
+        result->footprint &= benchFootprint(&rss[0], &fds[0]);
+        start = ogliNow();
+        for (run = 0; run < GLINFO_CHURN_RUNS && done; run++)
+            done = idx ? benchPooled(pool, ctx->profile, idx == 1, &create[run], &destroy[run]) :
+                         benchStandalone(ctx, &create[run], &destroy[run], result->phases);
+        if (!done)
+            break;
+        mode->rate = GLINFO_CHURN_RUNS / (ogliNow() - start);
+        result->footprint &= benchFootprint(&rss[1], &fds[1]);
+        mode->rssGrowth = rss[1] - rss[0];
+        mode->fdGrowth = fds[1] - fds[0];
+        benchLatencies(create, GLINFO_CHURN_RUNS, mode->create);
+        benchLatencies(destroy, GLINFO_CHURN_RUNS, mode->destroy);
+    }
+    if (pool)
+        ogliPoolDestroy(pool);
+
+    if (!done)
+    {
+        memset(result, 0, sizeof(GLINFO_CHURN_BENCH));
+        return "Error creating OpenGL context during the churn benchmark.";
+    }
+    for (idx = 0; idx < OGLI_TOTAL_PHASES; idx++)
+        result->phases[idx] = result->phases[idx] / GLINFO_CHURN_RUNS * 1e3;
+    return NULL;
+}
@@ -0,0 +1,101 @@
+/* OpenGL Information Query Utility - Benchmarks
+**
+** Copyrights (c) 2021-2023 by Trinh D.D. Nguyen <dzutrinh[]yahoo.com>
+** All Rights Reserved
+** 
+** Redistribution and use in source and binary forms, with or without 
+** modification, are permitted provided that the following conditions are met:
+** 
+** * Redistributions of source code must retain the above copyright notice, 
+**   this list of conditions and the following disclaimer.
+** * Redistributions in binary form must reproduce the above copyright notice, 
+**   this list of conditions and the following disclaimer in the documentation 
+**   and/or other materials provided with the distribution.
+** * The name of the author may be used to endorse or promote products 
+**   derived from this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE 
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF 
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+** THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef _GLINFO_BENCH_
+#define _GLINFO_BENCH_    1
+
+#include "ogli.h"
+
+#define GLINFO_BENCH_SIZE   (1024)      /* width and height of the offscreen framebuffer */
+
+/* benchmark selected by --bench */
+typedef enum {GLINFO_BENCH_NONE, GLINFO_BENCH_RASTER, GLINFO_BENCH_SHADERS, GLINFO_BENCH_CHURN} GLINFO_BENCH_MODE;
+
+/* Rasterization throughput, all figures are per second */
+typedef struct raster_bench
+{
+    double  fillOpaque;         /* Mpix/s, full screen quads without blending */
+    double  fillBlended;        /* Mpix/s, same quads alpha blended */
+    double  trisSmall;          /* Mtri/s, triangles covering 2 pixels */
+    double  trisLarge;          /* Mtri/s, triangles covering 8192 pixels */
+} GLINFO_RASTER_BENCH;
+
+#define GLINFO_SHADER_PROGRAMS  (4)   /* programs of the bundled corpus, trivial to uber-shader */
+
+/* Latencies of one program of the corpus, in milliseconds */
+typedef struct shader_bench_program
+{
+    const char  * name;
+    GLuint      sourceSize;     /* bytes of GLSL, both stages */
+    GLuint      binarySize;     /* bytes of the program binary, 0 without program binaries */
+    GLuint      runs;           /* measured builds */
+    double      compile[2];     /* p50 and p99, vertex and fragment stages */
+    double      link[2];
+    double      reload[2];      /* glProgramBinary of the linked program */
+} GLINFO_SHADER_PROGRAM;
+
+/* Shader build latencies and throughput */
+typedef struct shader_bench
+{
+    GLINFO_SHADER_PROGRAM programs[GLINFO_SHADER_PROGRAMS];
+    GLboolean   binary;         /* GL_ARB_get_program_binary with at least one format */
+    GLboolean   parallel;       /* GL_KHR_parallel_shader_compile or its ARB twin */
+    GLuint      threads;        /* GL_MAX_SHADER_COMPILER_THREADS_KHR of the parallel run, 0 when left to the driver */
+    double      serialRate;     /* programs/s, each one built and checked in turn */
+    double      parallelRate;   /* programs/s, all in flight and polled for completion */
+} GLINFO_SHADER_BENCH;
+
+#define GLINFO_CHURN_RUNS       (1000)  /* measured contexts of each churn mode */
+#define GLINFO_CHURN_MODES      (3)     /* standalone, fresh from a pool (pooled), idle from a pool (reused) */
+
+/* Latencies of one way to get a context, in milliseconds */
+typedef struct churn_bench_mode
+{
+    const char  * name;
+    double      create[2];      /* p50 and p99, until the context is current */
+    double      destroy[2];     /* p50 and p99, until it is destroyed or back in the pool */
+    double      rate;           /* contexts/s, create and destroy included */
+    long        rssGrowth;      /* KB the process grew by over the measured runs */
+    int         fdGrowth;       /* file descriptors left open by the measured runs */
+} GLINFO_CHURN_MODE;
+
+/* Context creation cost with and without a pool */
+typedef struct churn_bench
+{
+    GLINFO_CHURN_MODE modes[GLINFO_CHURN_MODES];
+    GLuint      runs;           /* per mode */
+    GLboolean   footprint;      /* rssGrowth and fdGrowth are measured, Linux only */
+    double      phases[OGLI_TOTAL_PHASES];  /* mean of each phase of a standalone context, ms */
+} GLINFO_CHURN_BENCH;
+
+const char* benchRaster(OGLI_CONTEXT * ctx, GLINFO_RASTER_BENCH * result);
+const char* benchShaders(OGLI_CONTEXT * ctx, GLINFO_SHADER_BENCH * result);
+const char* benchChurn(const OGLI_CONTEXT * ctx, GLINFO_CHURN_BENCH * result);
+
+#endif
@@ -0,0 +1,583 @@
+/* OpenGL Information Query Utility - Snapshot diff
+**
+** Copyrights (c) 2021-2023 by Trinh D.D. Nguyen <dzutrinh[]yahoo.com>
+** All Rights Reserved
+** 
+** Redistribution and use in source and binary forms, with or without 
+** modification, are permitted provided that the following conditions are met:
+** 
+** * Redistributions of source code must retain the above copyright notice, 
+**   this list of conditions and the following disclaimer.
+** * Redistributions in binary form must reproduce the above copyright notice, 
+**   this list of conditions and the following disclaimer in the documentation 
+**   and/or other materials provided with the distribution.
+** * The name of the author may be used to endorse or promote products 
+**   derived from this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE 
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF 
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+** THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <stdio.h>
+#include "diff.h"
+
+#define DIFF_MAX_DEPTH      (32)        /* nesting of our reports is 4 */
+
+/* entry of a sorted set, the value is NULL for extension names */
+typedef struct diff_entry
+{
+    const char              * name;
+    const GLINFO_DIFF_VALUE * value;
+} DIFF_ENTRY;
+
+typedef struct diff_counts
+{
+    GLuint  added;
+    GLuint  removed;
+    GLuint  changed;
+} DIFF_COUNTS;
+
+/*------------------------------------------------------------------------------------------------*/
+/*                                          PARSER                                                */
+/*------------------------------------------------------------------------------------------------*/
+
+static GLINFO_DIFF_VALUE * diffNode(GLINFO_SNAPSHOT * snap)
+{
+    GLINFO_DIFF_POOL * pool = snap->pool;
+
+    if (!pool || pool->used == GLINFO_DIFF_POOL_SIZE)
+    {
+        pool = (GLINFO_DIFF_POOL *) malloc(sizeof(GLINFO_DIFF_POOL));
+        if (!pool)
+            return NULL;
+        pool->next = snap->pool;
+        pool->used = 0;
+        snap->pool = pool;
+    }
+    memset(&pool->values[pool->used], 0, sizeof(GLINFO_DIFF_VALUE));
+    return &pool->values[pool->used++];
+}
+
+static char * diffSkip(char * p)
+{
+    while (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r')
+        p++;
+    return p;
+}
+
+static int diffHex(const char * p)
+{
+    int idx, code = 0;
+
+    for (idx = 0; idx < 4; idx++)
+    {
+        code <<= 4;
+        if (p[idx] >= '0' && p[idx] <= '9')         code |= p[idx] - '0';
+        else if (p[idx] >= 'a' && p[idx] <= 'f')    code |= p[idx] - 'a' + 10;
+        else if (p[idx] >= 'A' && p[idx] <= 'F')    code |= p[idx] - 'A' + 10;
+        else return -1;
+    }
+    return code;
+}
+
+static char * diffUtf8(char * out, int code)
+{
+    if (code < 0x80)
+        *out++ = (char) code;
+    else if (code < 0x800)
+    {
+        *out++ = (char) (0xC0 | (code >> 6));
+        *out++ = (char) (0x80 | (code & 0x3F));
+    }
+    else if (code < 0x10000)
+    {
+        *out++ = (char) (0xE0 | (code >> 12));
+        *out++ = (char) (0x80 | ((code >> 6) & 0x3F));
+        *out++ = (char) (0x80 | (code & 0x3F));
+    }
+    else
+    {
+        *out++ = (char) (0xF0 | (code >> 18));
+        *out++ = (char) (0x80 | ((code >> 12) & 0x3F));
+        *out++ = (char) (0x80 | ((code >> 6) & 0x3F));
+        *out++ = (char) (0x80 | (code & 0x3F));
+    }
+    return out;
+}
+
+/* unescapes a string in place, escapes are never shorter than what they stand for */
+static char * diffString(char * p, const char ** text, GLuint * length)
+{
+    char    * out = p;
+    int     code, low;
+
+    *text = p;
+    while (*p != '"')
+    {
+        if ((unsigned char) *p < 0x20)
+            return NULL;
+        if (*p != '\\')
+        {
+            *out++ = *p++;
+            continue;
+        }
+
+        switch (*++p)
+        {
+            case '"': case '\\': case '/': 
+                        *out++ = *p;    break;
+            case 'b':   *out++ = '\b';  break;
+            case 'f':   *out++ = '\f';  break;
+            case 'n':   *out++ = '\n';  break;
+            case 'r':   *out++ = '\r';  break;
+            case 't':   *out++ = '\t';  break;
+            case 'u':
+                code = diffHex(p + 1);
+                if (code < 0)
+                    return NULL;
+                p += 4;
+                if (code >= 0xD800 && code < 0xDC00 && p[1] == '\\' && p[2] == 'u')
+                {
+                    low = diffHex(p + 3);
+                    if (low >= 0xDC00 && low < 0xE000)
+                    {
+                        code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+                        p += 6;
+                    }
+                }
+                out = diffUtf8(out, code);
+                break;
+            default:
+                return NULL;
+        }
+        p++;
+    }
+    *length = (GLuint) (out - *text);
+    *out = 0;
+    return p + 1;
+}
+
+static char * diffValue(GLINFO_SNAPSHOT * snap, char * p, GLINFO_DIFF_VALUE * value, GLuint depth)
+{
+    GLINFO_DIFF_VALUE   ** tail = &value->child, * child;
+    GLuint              length;
+    char                close;
+
+    p = diffSkip(p);
+    if (depth > DIFF_MAX_DEPTH)
+        return NULL;
+
+    if (*p == '"')
+    {
+        value->type = DIFF_STRING;
+        return diffString(p + 1, &value->text, &value->length);
+    }
+
+    /* numbers and literals are compared as they were written */
+    if (*p != '{' && *p != '[')
+    {
+        value->type = DIFF_SCALAR;
+        value->text = p;
+        while (*p && strchr("+-.0123456789eEaflnrstu", *p))
+            p++;
+        value->length = (GLuint) (p - value->text);
+        return value->length ? p : NULL;
+    }
+
+    value->type = *p == '{' ? DIFF_OBJECT : DIFF_ARRAY;
+    close = *p == '{' ? '}' : ']';
+    p = diffSkip(p + 1);
+    if (*p == close)
+        return p + 1;
+
+    for (;;)
+    {
+        child = diffNode(snap);
+        if (!child)
+            return NULL;
+
+        if (value->type == DIFF_OBJECT)
+        {
+            if (*p != '"' || !(p = diffString(p + 1, &child->key, &length)))
+                return NULL;
+            p = diffSkip(p);
+            if (*p++ != ':')
+                return NULL;
+        }
+
+        p = diffValue(snap, p, child, depth + 1);
+        if (!p)
+            return NULL;
+        *tail = child;
+        tail = &child->next;
+        value->count++;
+
+        p = diffSkip(p);
+        if (*p == close)
+            return p + 1;
+        if (*p != ',')
+            return NULL;
+        p = diffSkip(p + 1);
+    }
+}
+
+/* takes the ownership of a zero-terminated, malloc'ed text */
+GLboolean diffParse(GLINFO_SNAPSHOT * snap, char * data)
+{
+    char * end;
+
+    memset(snap, 0, sizeof(GLINFO_SNAPSHOT));
+    snap->data = data;
+    snap->root = diffNode(snap);
+    if (!data || !snap->root)
+        return GL_FALSE;
+
+    end = diffValue(snap, data, snap->root, 0);
+    return end && *diffSkip(end) == 0;
+}
+
+GLboolean diffLoad(GLINFO_SNAPSHOT * snap, const char * path)
+{
+    FILE    * file = fopen(path, "rb");
+    char    * data = NULL;
+    long    size;
+
+    if (file && fseek(file, 0, SEEK_END) == 0 && (size = ftell(file)) >= 0 && fseek(file, 0, SEEK_SET) == 0)
+    {
+        data = (char *) malloc(size + 1);
+        if (data && fread(data, 1, size, file) == (size_t) size)
+            data[size] = 0;
+        else
+        {
+            free(data);
+            data = NULL;
+        }
+    }
+    if (file)
+        fclose(file);
+    return diffParse(snap, data);
+}
+
+void diffFree(GLINFO_SNAPSHOT * snap)
+{
+    GLINFO_DIFF_POOL * pool;
+
+    while (snap->pool)
+    {
+        pool = snap->pool;
+        snap->pool = pool->next;
+        free(pool);
+    }
+    free(snap->data);
+    snap->data = NULL;
+    snap->root = NULL;
+}
+
+/*------------------------------------------------------------------------------------------------*/
+/*                                          COMPARISON                                            */
+/*------------------------------------------------------------------------------------------------*/
+
+static const GLINFO_DIFF_VALUE * diffMember(const GLINFO_DIFF_VALUE * object, const char * key)
+{
+    const GLINFO_DIFF_VALUE * member;
+
+    if (!object || object->type != DIFF_OBJECT)
+        return NULL;
+    for (member = object->child; member; member = member->next)
+        if (strcmp(member->key, key) == 0)
+            return member;
+    return NULL;
+}
+
+static GLboolean diffEqual(const GLINFO_DIFF_VALUE * a, const GLINFO_DIFF_VALUE * b)
+{
+    if (a->type != b->type || a->count != b->count)
+        return GL_FALSE;
+    if (a->type == DIFF_SCALAR || a->type == DIFF_STRING)
+        return a->length == b->length && memcmp(a->text, b->text, a->length) == 0;
+
+    for (a = a->child, b = b->child; a && b; a = a->next, b = b->next)
+    {
+        if (a->key && strcmp(a->key, b->key) != 0)
+            return GL_FALSE;
+        if (!diffEqual(a, b))
+            return GL_FALSE;
+    }
+    return GL_TRUE;
+}
+
+/* limits with several values print like the CSV report */
+static void diffPrintValue(const GLINFO_DIFF_VALUE * value)
+{
+    const GLINFO_DIFF_VALUE * element;
+
+    if (value->type == DIFF_SCALAR || value->type == DIFF_STRING)
+    {
+        printf("%.*s", (int) value->length, value->text);
+        return;
+    }
+    for (element = value->child; element; element = element->next)
+    {
+        printf("%s", element == value->child ? "" : " ");
+        diffPrintValue(element);
+    }
+}
+
+static void diffPrint(char sign, const char * label, const DIFF_ENTRY * entry)
+{
+    printf("%c %s %s", sign, label, entry->name);
+    if (entry->value)
+    {
+        printf(": ");
+        diffPrintValue(entry->value);
+    }
+    printf("\n");
+}
+
+static int diffCompareEntries(const void * a, const void * b)
+{
+    return strcmp(((const DIFF_ENTRY *) a)->name, ((const DIFF_ENTRY *) b)->name);
+}
+
+/* names appearing twice in a driver string are compared once */
+static GLuint diffNext(const DIFF_ENTRY * entries, GLuint count, GLuint idx)
+{
+    const char * name = entries[idx].name;
+
+    while (++idx < count && strcmp(entries[idx].name, name) == 0)
+        ;
+    return idx;
+}
+
+/* Sorted merge of two sets. Entries found on one side only count as additions or removals,
+   unless the set only checks the values both sides hold. */
+static void diffMerge(DIFF_COUNTS * counts, const char * label, DIFF_ENTRY * before, GLuint beforeCount, 
+                      DIFF_ENTRY * after, GLuint afterCount, GLboolean common)
+{
+    GLuint  idx = 0, jdx = 0;
+    int     order;
+
+    qsort(before, beforeCount, sizeof(DIFF_ENTRY), diffCompareEntries);
+    qsort(after, afterCount, sizeof(DIFF_ENTRY), diffCompareEntries);
+
+    while (idx < beforeCount || jdx < afterCount)
+    {
+        if (idx == beforeCount)
+            order = 1;
+        else if (jdx == afterCount)
+            order = -1;
+        else
+            order = strcmp(before[idx].name, after[jdx].name);
+
+        if (order < 0)
+        {
+            if (!common)
+            {
+                diffPrint('-', label, &before[idx]);
+                counts->removed++;
+            }
+            idx = diffNext(before, beforeCount, idx);
+        }
+        else if (order > 0)
+        {
+            if (!common)
+            {
+                diffPrint('+', label, &after[jdx]);
+                counts->added++;
+            }
+            jdx = diffNext(after, afterCount, jdx);
+        }
+        else
+        {
+            if (before[idx].value && !diffEqual(before[idx].value, after[jdx].value))
+            {
+                printf("~ %s %s: ", label, before[idx].name);
+                diffPrintValue(before[idx].value);
+                printf(" -> ");
+                diffPrintValue(after[jdx].value);
+                printf("\n");
+                counts->changed++;
+            }
+            idx = diffNext(before, beforeCount, idx);
+            jdx = diffNext(after, afterCount, jdx);
+        }
+    }
+}
+
+/* strings of an array or scalar members of an object, NULL when there is nothing to compare */
+static DIFF_ENTRY * diffCollect(const GLINFO_DIFF_VALUE * set, GLuint * count)
+{
+    const GLINFO_DIFF_VALUE * item;
+    DIFF_ENTRY              * entries;
+
+    *count = 0;
+    if (!set || (set->type != DIFF_ARRAY && set->type != DIFF_OBJECT))
+        return NULL;
+    entries = (DIFF_ENTRY *) malloc((set->count + 1) * sizeof(DIFF_ENTRY));
+    if (!entries)
+        return NULL;
+
+    for (item = set->child; item; item = item->next)
+    {
+        if (set->type == DIFF_ARRAY && item->type == DIFF_STRING)
+        {
+            entries[*count].name = item->text;
+            entries[*count].value = NULL;
+            (*count)++;
+        }
+        else if (set->type == DIFF_OBJECT && item->type != DIFF_OBJECT && 
+                 (item->type != DIFF_ARRAY || item->child == NULL || item->child->type == DIFF_SCALAR))
+        {
+            entries[*count].name = item->key;
+            entries[*count].value = item;
+            (*count)++;
+        }
+    }
+    return entries;
+}
+
+/* a set missing from either snapshot was not exported, it is not compared */
+static void diffSet(DIFF_COUNTS * counts, const char * label, const GLINFO_DIFF_VALUE * before, 
+                    const GLINFO_DIFF_VALUE * after, GLboolean common)
+{
+    DIFF_ENTRY  * beforeEntries, * afterEntries;
+    GLuint      beforeCount, afterCount;
+
+    if (!before || !after)
+        return;
+
+    beforeEntries = diffCollect(before, &beforeCount);
+    afterEntries = diffCollect(after, &afterCount);
+    if (beforeEntries && afterEntries)
+        diffMerge(counts, label, beforeEntries, beforeCount, afterEntries, afterCount, common);
+    free(beforeEntries);
+    free(afterEntries);
+}
+
+static void diffProfile(DIFF_COUNTS * counts, const GLINFO_DIFF_VALUE * before, const GLINFO_DIFF_VALUE * after)
+{
+    const GLINFO_DIFF_VALUE * glBefore = diffMember(before, "gl"), * glAfter = diffMember(after, "gl");
+    const GLINFO_DIFF_VALUE * gluBefore = diffMember(before, "glu"), * gluAfter = diffMember(after, "glu");
+
+    diffSet(counts, "gl", glBefore, glAfter, GL_TRUE);
+    diffSet(counts, "extension", diffMember(glBefore, "extensions"), diffMember(glAfter, "extensions"), GL_FALSE);
+    diffSet(counts, "glu", gluBefore, gluAfter, GL_TRUE);
+    diffSet(counts, "glu extension", diffMember(gluBefore, "extensions"), diffMember(gluAfter, "extensions"), GL_FALSE);
+    diffSet(counts, "limit", diffMember(before, "limits"), diffMember(after, "limits"), GL_FALSE);
+}
+
+/* available profiles of a snapshot, a report of one profile is an object, of several an array */
+static DIFF_ENTRY * diffProfiles(const GLINFO_DIFF_VALUE * root, GLuint * count)
+{
+    const GLINFO_DIFF_VALUE * item = root->type == DIFF_ARRAY ? root->child : root;
+    const GLINFO_DIFF_VALUE * name;
+    DIFF_ENTRY              * entries;
+
+    *count = 0;
+    entries = (DIFF_ENTRY *) malloc((root->count + 1) * sizeof(DIFF_ENTRY));
+    for (; entries && item; item = root->type == DIFF_ARRAY ? item->next : NULL)
+    {
+        name = diffMember(item, "profile");
+        if (!name || name->type != DIFF_STRING || diffMember(item, "error"))
+            continue;
+        entries[*count].name = name->text;
+        entries[*count].value = item;
+        (*count)++;
+    }
+    return entries;
+}
+
+GLboolean diffLiveSetup(const GLINFO_SNAPSHOT * snap, GLINFO_SECTIONS * sections, OGLI_PROFILE * profile, GLboolean * all)
+{
+    const GLINFO_DIFF_VALUE * gl, * glu;
+    DIFF_ENTRY              * profiles;
+    GLuint                  count;
+
+    memset(sections, 0, sizeof(GLINFO_SECTIONS));
+    *all = snap->root->type == DIFF_ARRAY;
+    profiles = diffProfiles(snap->root, &count);
+    if (!profiles || !count)
+    {
+        free(profiles);
+        return GL_FALSE;
+    }
+
+    gl = diffMember(profiles[0].value, "gl");
+    sections->info = diffMember(gl, "vendor") != NULL;
+    /* GLU is loaded for its extensions as well, a snapshot of -e -l has no GLU version */
+    glu = diffMember(profiles[0].value, "glu");
+    sections->glu = diffMember(glu, "version") != NULL || diffMember(glu, "extensions") != NULL;
+    sections->extensions = diffMember(gl, "extensions") != NULL;
+    sections->maxVersion = diffMember(gl, "maxCore") != NULL;
+    sections->limits = diffMember(profiles[0].value, "limits") != NULL;
+
+    for (*profile = OGLI_LEGACY; *profile < OGLI_TOTAL_PROFILES; (*profile)++)
+        if (strcmp(profiles[0].name, ogliProfileName(*profile)) == 0)
+            break;
+    free(profiles);
+    return *profile < OGLI_TOTAL_PROFILES;
+}
+
+/* 0 when identical, 1 when there are only additions, 2 when anything was removed or changed */
+int diffCompare(const GLINFO_SNAPSHOT * before, const GLINFO_SNAPSHOT * after)
+{
+    DIFF_ENTRY  * beforeProfiles, * afterProfiles;
+    DIFF_COUNTS counts;
+    GLuint      beforeCount, afterCount, idx = 0, jdx = 0;
+    GLboolean   headers = before->root->type == DIFF_ARRAY || after->root->type == DIFF_ARRAY;
+    int         order;
+
+    memset(&counts, 0, sizeof(counts));
+    beforeProfiles = diffProfiles(before->root, &beforeCount);
+    afterProfiles = diffProfiles(after->root, &afterCount);
+    if (beforeProfiles && afterProfiles)
+    {
+        qsort(beforeProfiles, beforeCount, sizeof(DIFF_ENTRY), diffCompareEntries);
+        qsort(afterProfiles, afterCount, sizeof(DIFF_ENTRY), diffCompareEntries);
+    }
+    else
+        beforeCount = afterCount = 0;
+
+    while (idx < beforeCount || jdx < afterCount)
+    {
+        if (idx == beforeCount)
+            order = 1;
+        else if (jdx == afterCount)
+            order = -1;
+        else
+            order = strcmp(beforeProfiles[idx].name, afterProfiles[jdx].name);
+
+        if (order < 0)
+        {
+            printf("- profile %s\n", beforeProfiles[idx++].name);
+            counts.removed++;
+        }
+        else if (order > 0)
+        {
+            printf("+ profile %s\n", afterProfiles[jdx++].name);
+            counts.added++;
+        }
+        else
+        {
+            if (headers)
+                printf("=== %s profile ===\n", beforeProfiles[idx].name);
+            diffProfile(&counts, beforeProfiles[idx++].value, afterProfiles[jdx++].value);
+        }
+    }
+    free(beforeProfiles);
+    free(afterProfiles);
+
+    printf("%u added, %u removed, %u changed\n", counts.added, counts.removed, counts.changed);
+    if (counts.removed || counts.changed)
+        return 2;
+    return counts.added ? 1 : 0;
+}
@@ -0,0 +1,72 @@
+/* OpenGL Information Query Utility - Snapshot diff
+**
+** Copyrights (c) 2021-2023 by Trinh D.D. Nguyen <dzutrinh[]yahoo.com>
+** All Rights Reserved
+** 
+** Redistribution and use in source and binary forms, with or without 
+** modification, are permitted provided that the following conditions are met:
+** 
+** * Redistributions of source code must retain the above copyright notice, 
+**   this list of conditions and the following disclaimer.
+** * Redistributions in binary form must reproduce the above copyright notice, 
+**   this list of conditions and the following disclaimer in the documentation 
+**   and/or other materials provided with the distribution.
+** * The name of the author may be used to endorse or promote products 
+**   derived from this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE 
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF 
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+** THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef _GLINFO_DIFF_
+#define _GLINFO_DIFF_    1
+
+#include "report.h"
+
+#define GLINFO_DIFF_POOL_SIZE   (1024)      /* values allocated at once */
+
+/* JSON value of a snapshot, strings point into the parsed text */
+typedef enum {DIFF_SCALAR, DIFF_STRING, DIFF_ARRAY, DIFF_OBJECT} GLINFO_DIFF_TYPE;
+
+typedef struct diff_value
+{
+    GLINFO_DIFF_TYPE    type;
+    const char          * key;      /* member name inside an object */
+    const char          * text;     /* strings, numbers and literals */
+    GLuint              length;
+    GLuint              count;      /* elements of an array or members of an object */
+    struct diff_value   * child;
+    struct diff_value   * next;
+} GLINFO_DIFF_VALUE;
+
+typedef struct diff_pool
+{
+    struct diff_pool    * next;
+    GLuint              used;
+    GLINFO_DIFF_VALUE   values[GLINFO_DIFF_POOL_SIZE];
+} GLINFO_DIFF_POOL;
+
+/* --format=json report loaded back, parsed in place */
+typedef struct diff_snapshot
+{
+    char                * data;
+    GLINFO_DIFF_POOL    * pool;
+    GLINFO_DIFF_VALUE   * root;
+} GLINFO_SNAPSHOT;
+
+GLboolean   diffLoad(GLINFO_SNAPSHOT * snap, const char * path);
+GLboolean   diffParse(GLINFO_SNAPSHOT * snap, char * data);
+GLboolean   diffLiveSetup(const GLINFO_SNAPSHOT * snap, GLINFO_SECTIONS * sections, OGLI_PROFILE * profile, GLboolean * all);
+int         diffCompare(const GLINFO_SNAPSHOT * before, const GLINFO_SNAPSHOT * after);
+void        diffFree(GLINFO_SNAPSHOT * snap);
+
+#endif
@@ -33,28 +33,103 @@
 ** v1.1: Linux support added
 ** v1.2: improving extensions listing 
 ** v1.3: fix buffer overflow bugs when query OpenGL information
+** v1.4: headless EGL backend on Linux (--backend=egl)
+** v1.5: windowless GLX context through pbuffer or no drawable (-w)
+** v1.6: opt-in capability cache (--cache, --no-cache, --refresh)
+** v1.7: implementation limits listing (-l)
+** v1.8: compatibility and forward-compatible profiles, concurrent probing (--all-profiles)
+** v1.9: highest core and compatibility context versions discovery (--max-version)
+** v1.10: rasterization throughput benchmark (--bench raster)
+** v1.11: per-phase timings and Chrome trace export (--timings[=file])
+** v1.12: framebuffer configs listing (--fbconfigs)
+** v1.13: JSON and CSV output written at once (--format=text|json|csv)
+** v1.14: query daemon on a Unix socket and its client (--serve, --query)
+** v1.15: capability snapshots comparison (--diff)
+** v1.16: several X displays and screens probed by a worker pool (--displays, --all-screens)
+** v1.17: shader compile, link and program binary reload latencies (--bench shaders)
+** v1.18: internal format capability matrix (--formats)
+** v1.19: renderer identity without a context through GLX_MESA_query_renderer (--quick)
+** v1.20: only the information asked for is queried, -i loads neither GLU nor the extension list
+** v1.21: video memory and GPU heartbeat monitor writing NDJSON (--watch)
+** v1.22: context creation cost, standalone and through a context pool (--bench churn)
 **
 */
 
 #include <stdio.h>
 #include "ogli.h"
+#include "diff.h"
+#include "serve.h"
+#include "watch.h"
+
+#ifndef _WIN32
+#   include <pthread.h>
+#endif
 
 #define GLINFO_MAJOR_VERSION    1
-#define GLINFO_MINOR_VERSION    3
+#define GLINFO_MINOR_VERSION    22
+#define GLINFO_MAX_DISPLAYS     64      /* entries of --displays */
+#define GLINFO_MAX_WORKERS      8       /* probing threads of the pool */
 
 const char * HELP_MSG = "OpenGL information query utility - v%d.%d (%s)\n"
                         "Coded by Trinh D.D. Nguyen\n\n"
-                        "Usage: glinfo [-hiecv]\n"
+                        "Usage: glinfo [-hieclvw] [--backend=native|egl]\n"
                         "Where as: -h, --help       give this help message\n"
                         "          -c, --core       query by core profile, default is legacy profile\n"
+                        "          --profile=name   query by legacy, core, compat or forward profile\n"
+                        "          --all-profiles   query every profile concurrently\n"
+                        "          --displays=list  query each X display of a comma separated list (Linux only)\n"
+                        "          --all-screens    query every screen of the displays (Linux only)\n"
+                        "          --timings[=file] time each phase, optionally save a Chrome trace\n"
                         "          -e, --extension  list all extensions only\n"
-                        "          -i, --info       display OpenGL information, use combine with -e\n"
-                        "          -v, --version    display program's version number\n";
+                        "          -i, --info       display OpenGL information, use combine with -e or -l\n"
+                        "          -l, --limits     list implementation limits\n"
+                        "          --quick          show renderer, PCI IDs and VRAM, with no context when possible\n"
+                        "          --fbconfigs      list the framebuffer configs of the display (Linux only)\n"
+                        "          --formats        list support, upload format and samples of internal formats\n"
+                        "          --serve path     answer queries on a Unix socket (Linux only)\n"
+                        "          --query path req ask a running daemon: ping, ext NAME..., limit NAME, report [fmt]\n"
+                        "          --diff old [new] compare JSON snapshots, or a snapshot with the live context\n"
+                        "          --watch seconds  sample video memory or a GPU heartbeat, print NDJSON until interrupted\n"
+                        "          --format=name    print as text, json or csv, default is text\n"
+                        "          --max-version    discover the highest core and compat context versions\n"
+                        "          --bench raster   measure fill rate and triangle rate offscreen\n"
+                        "          --bench shaders  measure shader compile, link and reload latencies\n"
+                        "          --bench churn    measure context create and destroy latencies, with and without a pool\n"
+                        "          -v, --version    display program's version number\n"
+                        "          -w, --windowless do not map a window to query (Linux only)\n"
+                        "          --backend=egl    create a headless EGL context (Linux only)\n"
+                        "          --cache          reuse cached results, also enabled by GLINFO_CACHE=1\n"
+                        "          --no-cache       always query the driver\n"
+                        "          --refresh        query the driver and update the cache\n";
 
 GLboolean       extShow = GL_FALSE;
 GLboolean       infShow = GL_TRUE;
+GLboolean       infAsked = GL_FALSE;
+GLboolean       limShow = GL_FALSE;
 GLboolean       valid = GL_FALSE;
+GLboolean       windowless = GL_FALSE;
+GLboolean       useCache = GL_FALSE;
+GLboolean       refreshCache = GL_FALSE;
+GLboolean       allProfiles = GL_FALSE;
+GLboolean       maxVersion = GL_FALSE;
+GLINFO_BENCH_MODE benchMode = GLINFO_BENCH_NONE;
+GLboolean       timings = GL_FALSE;
+GLboolean       fbcShow = GL_FALSE;
+GLboolean       fmtShow = GL_FALSE;
+GLboolean       quick = GL_FALSE;
+GLboolean       gluShow = GL_TRUE;
+const char      * traceFile = NULL;
+GLINFO_FORMAT   format = GLINFO_FORMAT_TEXT;
+const char      * servePath = NULL;
+const char      * queryPath = NULL;
+GLint           queryArg = 0;
+const char      * diffBefore = NULL;
+const char      * diffAfter = NULL;
+double          watchInterval = 0;
+char            * displayList = NULL;
+GLboolean       allScreens = GL_FALSE;
 OGLI_PROFILE    profile = OGLI_LEGACY;
+OGLI_BACKEND    backend = OGLI_BACKEND_NATIVE;
 
 void die(const char * msg)
 {
@@ -78,6 +153,10 @@ void showVersions()
 GLboolean parseArgs(int argc, char ** argv)
 {
     GLint       idx;
+    const char  * env = getenv("GLINFO_CACHE");
+
+    /* fleet wide opt-in, the command line still has the last word */
+    useCache = env && *env && strcmp(env, "0") != 0;
 
     if (argc > 1)
     {
@@ -102,86 +181,725 @@ GLboolean parseArgs(int argc, char ** argv)
                 valid = GL_TRUE;
             }
 
+            if (strncmp(argv[idx], "--profile=", 10) == 0)
+            {
+                for (profile = OGLI_LEGACY; profile < OGLI_TOTAL_PROFILES; profile++)
+                    if (strcmp(argv[idx] + 10, ogliProfileName(profile)) == 0)
+                        break;
+                if (profile == OGLI_TOTAL_PROFILES)
+                    die("Unknown OpenGL profile.");
+                valid = GL_TRUE;
+            }
+
+            if (strcmp(argv[idx], "--max-version") == 0)
+            {
+                maxVersion = GL_TRUE;
+                valid = GL_TRUE;
+            }
+
+            if (strcmp(argv[idx], "--bench") == 0)
+            {
+                if (idx + 1 < argc && strcmp(argv[idx + 1], "raster") == 0)
+                    benchMode = GLINFO_BENCH_RASTER;
+                else if (idx + 1 < argc && strcmp(argv[idx + 1], "shaders") == 0)
+                    benchMode = GLINFO_BENCH_SHADERS;
+                else if (idx + 1 < argc && strcmp(argv[idx + 1], "churn") == 0)
+                    benchMode = GLINFO_BENCH_CHURN;
+                else
+                    die("Unknown benchmark.");
+                idx++;
+                valid = GL_TRUE;
+            }
+
+            if (strcmp(argv[idx], "--timings") == 0 || strncmp(argv[idx], "--timings=", 10) == 0)
+            {
+                timings = GL_TRUE;
+                traceFile = argv[idx][9] == '=' ? argv[idx] + 10 : NULL;
+                valid = GL_TRUE;
+            }
+
+            if (strcmp(argv[idx], "--serve") == 0)
+            {
+                if (idx + 1 >= argc)
+                    die("Missing socket path.");
+                servePath = argv[++idx];
+                valid = GL_TRUE;
+            }
+
+            if (strcmp(argv[idx], "--watch") == 0)
+            {
+                char * end;
+
+                if (idx + 1 >= argc)
+                    die("Missing watch interval.");
+                watchInterval = strtod(argv[++idx], &end);
+                if (end == argv[idx] || *end || !(watchInterval >= 0.001))
+                    die("Invalid watch interval.");
+                valid = GL_TRUE;
+            }
+
+            /* the rest of the command line is the request */
+            if (strcmp(argv[idx], "--query") == 0)
+            {
+                if (idx + 2 >= argc)
+                    die("Missing socket path or request.");
+                queryPath = argv[idx + 1];
+                queryArg = idx + 2;
+                valid = GL_TRUE;
+                break;
+            }
+
+            /* the second snapshot is optional, the live context stands in for it */
+            if (strcmp(argv[idx], "--diff") == 0)
+            {
+                if (idx + 1 >= argc)
+                    die("Missing snapshot to compare.");
+                diffBefore = argv[++idx];
+                if (idx + 1 < argc && argv[idx + 1][0] != '-')
+                    diffAfter = argv[++idx];
+                valid = GL_TRUE;
+            }
+
+            if (strncmp(argv[idx], "--format=", 9) == 0)
+            {
+                if (strcmp(argv[idx] + 9, "text") == 0)
+                    format = GLINFO_FORMAT_TEXT;
+                else if (strcmp(argv[idx] + 9, "json") == 0)
+                    format = GLINFO_FORMAT_JSON;
+                else if (strcmp(argv[idx] + 9, "csv") == 0)
+                    format = GLINFO_FORMAT_CSV;
+                else
+                    die("Unknown output format.");
+                valid = GL_TRUE;
+            }
+
+            if (strcmp(argv[idx], "--all-profiles") == 0)
+            {
+                allProfiles = GL_TRUE;
+                valid = GL_TRUE;
+            }
+
+            if (strncmp(argv[idx], "--displays=", 11) == 0)
+            {
+                displayList = argv[idx] + 11;
+                if (!*displayList)
+                    die("Missing X display list.");
+                valid = GL_TRUE;
+            }
+
+            if (strcmp(argv[idx], "--all-screens") == 0)
+            {
+                allScreens = GL_TRUE;
+                valid = GL_TRUE;
+            }
+
+            if (strcmp(argv[idx], "-w") == 0 || strcmp(argv[idx], "--windowless") == 0)
+            {
+                windowless = GL_TRUE;
+                valid = GL_TRUE;
+            }
+
+            if (strcmp(argv[idx], "--cache") == 0)
+            {
+                useCache = GL_TRUE;
+                valid = GL_TRUE;
+            }
+
+            if (strcmp(argv[idx], "--no-cache") == 0)
+            {
+                useCache = GL_FALSE;
+                refreshCache = GL_FALSE;
+                valid = GL_TRUE;
+            }
+
+            if (strcmp(argv[idx], "--refresh") == 0)
+            {
+                useCache = GL_TRUE;
+                refreshCache = GL_TRUE;
+                valid = GL_TRUE;
+            }
+
+            if (strncmp(argv[idx], "--backend=", 10) == 0)
+            {
+                if (strcmp(argv[idx] + 10, "egl") == 0)
+                    backend = OGLI_BACKEND_EGL;
+                else if (strcmp(argv[idx] + 10, "native") == 0)
+                    backend = OGLI_BACKEND_NATIVE;
+                else
+                    die("Unknown context backend.");
+                valid = GL_TRUE;
+            }
+
             if (strcmp(argv[idx], "-e") == 0 || strcmp(argv[idx], "--extension") == 0)
             {
                 extShow = GL_TRUE;
-                infShow = GL_FALSE;
+                infShow = infAsked;
+                valid = GL_TRUE;
+            }
+
+            if (strcmp(argv[idx], "-l") == 0 || strcmp(argv[idx], "--limits") == 0)
+            {
+                limShow = GL_TRUE;
+                infShow = infAsked;
+                valid = GL_TRUE;
+            }
+
+            if (strcmp(argv[idx], "--fbconfigs") == 0)
+            {
+                fbcShow = GL_TRUE;
+                infShow = infAsked;
+                valid = GL_TRUE;
+            }
+
+            if (strcmp(argv[idx], "--formats") == 0)
+            {
+                fmtShow = GL_TRUE;
+                infShow = infAsked;
+                valid = GL_TRUE;
+            }
+
+            if (strcmp(argv[idx], "--quick") == 0)
+            {
+                quick = GL_TRUE;
+                infShow = infAsked;
                 valid = GL_TRUE;
             }
 
             if (strcmp(argv[idx], "-i") == 0 || strcmp(argv[idx], "--info") == 0)
             {
                 infShow = GL_TRUE;
+                infAsked = GL_TRUE;
                 valid = GL_TRUE;
             }
         }
         if (!valid)
             die("Unknown command line option.");
+        /* the default report still shows the GLU version, an explicit -i only the OpenGL strings */
+        gluShow = extShow || (infShow && !infAsked);
+        if (allProfiles && benchMode != GLINFO_BENCH_NONE)
+            die("Benchmarks cannot run concurrently with --all-profiles.");
+        if (servePath && (allProfiles || benchMode != GLINFO_BENCH_NONE))
+            die("The query daemon serves a single profile without benchmarks.");
+        if ((displayList || allScreens) && (servePath || diffBefore || benchMode != GLINFO_BENCH_NONE))
+            die("X displays cannot be combined with --serve, --diff or benchmarks.");
+        if (quick && (servePath || diffBefore))
+            die("--quick cannot be combined with --serve or --diff.");
+        if (watchInterval > 0 && (servePath || diffBefore || displayList || allScreens || allProfiles || 
+                                  quick || benchMode != GLINFO_BENCH_NONE))
+            die("--watch monitors a single profile on its own.");
+        if ((displayList || allScreens) && backend != OGLI_BACKEND_NATIVE)
+            die("X displays are only probed by the native backend.");
     }
     return GL_TRUE;
 }
 
-void showInfo(const OGLI_CONTEXT * ctx)
+/* Chrome trace-event format, one complete event per phase and one thread per context */
+void writeTrace(const char * path, OGLI_CONTEXT ** ctxs, GLuint count)
 {
-    GLubyte *token, *temp;
-    GLuint  extLen, count = 0;
+    const OGLI_TIMING   * timing;
+    double              base;
+    GLuint              idx, phase;
+    const char          * sep = "";
+    FILE                * file = fopen(path, "w");
 
-    printf(">>> OpenGL\n");
-    if (infShow)
+    if (!file)
     {
-        printf(" . Vendor      : %s\n", ctx->iblock.glVendor);
-        printf(" . Renderer    : %s\n", ctx->iblock.glRenderer);
-        printf(" . Version     : %s\n", ctx->iblock.glVersion);
-        printf(" . GLSL        : %s\n", ctx->iblock.glSL);
-        printf(" . Extensions  : %u total\n", ctx->iblock.totalExtensions);
+        fprintf(stderr, "WARNING: Unable to write trace file %s.\n", path);
+        return;
     }
 
-    if (extShow)
+    for (idx = 1, base = ctxs[0]->timeBase; idx < count; idx++)
+        if (ctxs[idx]->timeBase < base)
+            base = ctxs[idx]->timeBase;
+
+    fprintf(file, "{\"traceEvents\":[");
+    for (idx = 0; idx < count; idx++)
     {
-        extLen = strlen(ctx->iblock.glExtensions);
-        temp = (GLubyte *) malloc(extLen); 
-        strcpy((char *) temp, ctx->iblock.glExtensions);
-        token = (GLubyte *) strtok((char *) temp, " ");
-        while (token)
+        fprintf(file, "%s\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"%s\"}}",
+                sep, idx + 1, ogliProfileName(ctxs[idx]->profile));
+        sep = ",";
+        timing = ogliGetTimings(ctxs[idx]);
+        for (phase = 0; phase < OGLI_TOTAL_PHASES; phase++)
         {
-            printf("%4d %s\n", ++count, token);
-            token = (GLubyte *) strtok(NULL, " ");
+            if (!timing[phase].count)
+                continue;
+            fprintf(file, ",\n{\"name\":\"%s\",\"cat\":\"ogli\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.1f,\"dur\":%.1f}",
+                    ogliPhaseName((OGLI_PHASE) phase), idx + 1,
+                    (ctxs[idx]->timeBase - base + timing[phase].start) * 1e6, timing[phase].duration * 1e6);
         }
-        free(temp);
     }
+    fprintf(file, "\n],\"displayTimeUnit\":\"ms\"}\n");
+    if (fclose(file) != 0)
+        fprintf(stderr, "WARNING: Unable to write trace file %s.\n", path);
+}
 
-    printf("\n>>> OpenGLU\n");
-    if (infShow)
-        printf(" . Version     : %s\n", ctx->iblock.gluVersion);
+/* parts of the information block the report needs, the cache and the daemon keep whole blocks */
+GLuint queryMask()
+{
+    GLuint mask = OGLI_Q_BASIC;
 
+    if (useCache || servePath)
+        return OGLI_Q_ALL;
     if (extShow)
+        mask |= OGLI_Q_EXTENSIONS;
+    if (limShow)
+        mask |= OGLI_Q_LIMITS;
+    if (gluShow)
+        mask |= OGLI_Q_GLU;
+    return mask;
+}
+
+/* runs the query pipeline on a fresh context, returns an error message or NULL */
+const char * probe(GLINFO_JOB * job)
+{
+    OGLI_CONTEXT * ctx = job->ctx;
+    const char   * error;
+
+    ogliSetTimings(ctx, timings);
+    if (!ogliSetBackend(ctx, backend))
+        return "Context backend is not available.";
+    ogliSetWindowless(ctx, windowless);
+    if (job->display && !ogliSetDisplay(ctx, job->display, job->screen))
+        return "X displays can only be selected on Linux.";
+
+    /* the renderer alone is answered by the display, a context is only created when it cannot */
+    if (quick && !infShow && !extShow && !limShow && !maxVersion && !fbcShow && !fmtShow && 
+        benchMode == GLINFO_BENCH_NONE && ogliQueryRenderer(ctx))
+        return NULL;
+
+    /* a cache hit skips context creation entirely, version discovery, configs and benchmarks need a context */
+    if (useCache && !refreshCache && !maxVersion && !fbcShow && !fmtShow && benchMode == GLINFO_BENCH_NONE && ogliCacheLoad(ctx, NULL))
+        return NULL;
+
+    /* contexts are churned before this one exists, it would keep the display alive for them */
+    if (benchMode == GLINFO_BENCH_CHURN)
+    {
+        error = benchChurn(ctx, &job->churn);
+        if (error)
+            return error;
+    }
+
+    if (!ogliCreateContext(ctx))    return "Error creating OpenGL context.";
+    if (!ogliQueryEx(ctx, queryMask()))
+                                    return "Error fetching OpenGL information.";
+    if (quick)
+        ogliQueryRenderer(ctx);     /* the strings of the context are enough without it */
+    if (maxVersion && !ogliDiscoverVersions(ctx))
+                                    return "Error discovering OpenGL context versions.";
+    if (fmtShow && !ogliQueryFormats(ctx))
+                                    return "Error querying internal formats.";
+    if (fbcShow && !ogliQueryFBConfigs(ctx, NULL))
+                                    return "Error listing framebuffer configs.";
+    if (benchMode == GLINFO_BENCH_RASTER)
     {
-        count = 0;
-        extLen = strlen(ctx->iblock.gluExtensions);
-        temp = (GLubyte *) malloc(extLen); 
-        strcpy((char *) temp, ctx->iblock.gluExtensions);
-        token = (GLubyte *) strtok((char *) temp, " ");
-        while (token)
+        error = benchRaster(ctx, &job->raster);
+        if (error)
         {
-            printf("%4d %s\n", ++count, token);
-            token = (GLubyte *) strtok(NULL, " ");
+            ogliDestroyContext(ctx);
+            return error;
         }
-        free(temp);
     }
+    if (benchMode == GLINFO_BENCH_SHADERS)
+    {
+        error = benchShaders(ctx, &job->shaders);
+        if (error)
+        {
+            ogliDestroyContext(ctx);
+            return error;
+        }
+    }
+    if (!ogliDestroyContext(ctx))   return "Error destroying rendering OpenGL context.";
+    if (useCache && !ogliCacheStore(ctx, NULL))
+        fprintf(stderr, "WARNING: Unable to update the capability cache.\n");
+    return NULL;
 }
 
-int main(int argc, char **argv)
+/* sections asked for on the command line */
+void reportSections(GLINFO_SECTIONS * sections)
 {
-    OGLI_CONTEXT        * ctx = NULL;
+    sections->info = infShow;
+    sections->glu = gluShow;
+    sections->renderer = quick;
+    sections->extensions = extShow;
+    sections->limits = limShow;
+    sections->maxVersion = maxVersion;
+    sections->raster = benchMode == GLINFO_BENCH_RASTER;
+    sections->shaders = benchMode == GLINFO_BENCH_SHADERS;
+    sections->churn = benchMode == GLINFO_BENCH_CHURN;
+    sections->fbconfigs = fbcShow;
+    sections->formats = fmtShow;
+    sections->timings = timings;
+}
+
+/* everything that was asked for, rendered in one buffer and written at once */
+void showReport(const GLINFO_JOB * jobs, GLuint count, GLboolean profiles)
+{
+    GLINFO_SECTIONS sections;
+    GLINFO_REPORT   report;
+
+    reportSections(&sections);
+    if (!reportRender(&report, format, &sections, jobs, count, profiles))
+        fprintf(stderr, "WARNING: Not enough memory, the report is truncated.\n");
+    fflush(stdout);
+    if (!reportWrite(&report, 1))
+        fprintf(stderr, "WARNING: Unable to write the report.\n");
+    reportFree(&report);
+}
+
+/* tasks shared by a bounded number of threads, each one takes the next task until none is left */
+typedef void (*GLINFO_TASK)(void * data, GLuint idx);
+
+typedef struct probe_pool
+{
+    GLINFO_TASK     task;
+    void            * data;
+    GLuint          count;
+#ifdef _WIN32
+    volatile LONG   next;
+#else
+    GLuint          next;
+    pthread_mutex_t lock;
+#endif
+} GLINFO_POOL;
+
+#ifdef _WIN32
+DWORD WINAPI poolWorker(LPVOID arg)
+#else
+void * poolWorker(void * arg)
+#endif
+{
+    GLINFO_POOL * pool = (GLINFO_POOL *) arg;
+    GLuint      idx;
+
+    for (;;)
+    {
+#ifdef _WIN32
+        idx = (GLuint) InterlockedIncrement(&pool->next) - 1;
+#else
+        pthread_mutex_lock(&pool->lock);
+        idx = pool->next < pool->count ? pool->next++ : pool->count;
+        pthread_mutex_unlock(&pool->lock);
+#endif
+        if (idx >= pool->count)
+            break;
+        pool->task(pool->data, idx);
+    }
+    return 0;
+}
+
+/* runs count tasks on at most GLINFO_MAX_WORKERS threads and waits for all of them */
+void runPool(GLINFO_TASK task, void * data, GLuint count)
+{
+    GLINFO_POOL pool;
+    GLuint      idx, workers = count < GLINFO_MAX_WORKERS ? count : GLINFO_MAX_WORKERS;
+#ifdef _WIN32
+    HANDLE      threads[GLINFO_MAX_WORKERS];
+#else
+    pthread_t   threads[GLINFO_MAX_WORKERS];
+    GLboolean   started[GLINFO_MAX_WORKERS];
+#endif
+
+    pool.task = task;
+    pool.data = data;
+    pool.count = count;
+    pool.next = 0;
+    /* the calling thread drains whatever the workers that failed to start leave behind */
+#ifdef _WIN32
+    for (idx = 0; idx < workers; idx++)
+        threads[idx] = CreateThread(NULL, 0, poolWorker, &pool, 0, NULL);
+    poolWorker(&pool);
+    for (idx = 0; idx < workers; idx++)
+    {
+        if (threads[idx])
+        {
+            WaitForSingleObject(threads[idx], INFINITE);
+            CloseHandle(threads[idx]);
+        }
+    }
+#else
+    pthread_mutex_init(&pool.lock, NULL);
+    for (idx = 0; idx < workers; idx++)
+        started[idx] = pthread_create(&threads[idx], NULL, poolWorker, &pool) == 0;
+    poolWorker(&pool);
+    for (idx = 0; idx < workers; idx++)
+        if (started[idx])
+            pthread_join(threads[idx], NULL);
+    pthread_mutex_destroy(&pool.lock);
+#endif
+}
+
+void probeTask(void * data, GLuint idx)
+{
+    GLINFO_JOB * jobs = (GLINFO_JOB *) data;
+
+    /* jobs of unreachable displays already carry their error */
+    if (!jobs[idx].error)
+        jobs[idx].error = probe(&jobs[idx]);
+}
+
+/* total time follows the slowest job as long as there are no more jobs than workers */
+void probeConcurrently(GLINFO_JOB * jobs, GLuint count)
+{
+    runPool(probeTask, jobs, count);
+}
+
+int probeAllProfiles()
+{
+    GLINFO_JOB  jobs[OGLI_TOTAL_PROFILES];
+    OGLI_CONTEXT * ctxs[OGLI_TOTAL_PROFILES];
+    GLuint      idx, failed = 0;
+
+    memset(jobs, 0, sizeof(jobs));
+    for (idx = 0; idx < OGLI_TOTAL_PROFILES; idx++)
+    {
+        jobs[idx].ctx = ogliInit((OGLI_PROFILE) idx);
+        if (!jobs[idx].ctx)
+            die("Cannot init OGLI library.");
+    }
+
+    probeConcurrently(jobs, OGLI_TOTAL_PROFILES);
+
+    for (idx = 0; idx < OGLI_TOTAL_PROFILES; idx++)
+        if (jobs[idx].error)
+            failed++;
+    showReport(jobs, OGLI_TOTAL_PROFILES, GL_TRUE);
+
+    if (traceFile)
+    {
+        for (idx = 0; idx < OGLI_TOTAL_PROFILES; idx++)
+            ctxs[idx] = jobs[idx].ctx;
+        writeTrace(traceFile, ctxs, OGLI_TOTAL_PROFILES);
+    }
+    for (idx = 0; idx < OGLI_TOTAL_PROFILES; idx++)
+        ogliShutdown(jobs[idx].ctx);
+
+    return failed == OGLI_TOTAL_PROFILES ? -1 : 0;
+}
+
+/* the context is queried once, the daemon answers from the information block */
+int serveProfile(GLINFO_JOB * job)
+{
+    GLINFO_SECTIONS sections;
+    int             status;
+
+    reportSections(&sections);
+    sections.info = sections.glu = sections.extensions = sections.limits = GL_TRUE;
+    sections.fbconfigs = sections.timings = GL_FALSE;
+    status = serveRun(servePath, job, &sections);
+    ogliShutdown(job->ctx);
+    return status;
+}
+
+/* the context stays current on this thread for as long as it is watched */
+int watchProfile()
+{
+    OGLI_CONTEXT    * ctx;
+    int             status;
 
-    if (!parseArgs(argc, argv))     return 0;
     ctx = ogliInit(profile);
-    if (!ctx)                       die("Cannot init OGLI library.");
-    if (!ogliCreateContext(ctx))    die("Error creating OpenGL context.");
-    if (!ogliQuery(ctx))            die("Error fetching OpenGL information.");
-    if (!ogliDestroyContext(ctx))   die("Error destroying rendering OpenGL context.");
-    showInfo(ctx);
+    if (!ctx)
+        die("Cannot init OGLI library.");
+    if (!ogliSetBackend(ctx, backend))
+        die("Context backend is not available.");
+    ogliSetWindowless(ctx, windowless);
+    if (!ogliCreateContext(ctx))
+        die("Error creating OpenGL context.");
+    if (!ogliQueryEx(ctx, OGLI_Q_BASIC))
+        die("Error fetching OpenGL information.");
+    status = watchRun(ctx, watchInterval);
     ogliShutdown(ctx);
+    return status;
+}
+
+int queryDaemon(int argc, char ** argv)
+{
+    char    request[GLINFO_SERVE_MAX_REQUEST + 1];
+    size_t  used = 0, length;
+    GLint   idx;
+
+    for (idx = queryArg; idx < argc; idx++)
+    {
+        length = strlen(argv[idx]);
+        if (used + (used != 0) + length >= sizeof(request))
+            die("Request is too long.");
+        if (used)
+            request[used++] = ' ';
+        memcpy(request + used, argv[idx], length);
+        used += length;
+    }
+    request[used] = 0;
+    return serveQuery(queryPath, request);
+}
+
+typedef struct display_list
+{
+    const char  * names[GLINFO_MAX_DISPLAYS];
+    GLint       screens[GLINFO_MAX_DISPLAYS];   /* 0 when the display cannot be opened */
+} GLINFO_DISPLAYS;
+
+void countTask(void * data, GLuint idx)
+{
+    GLINFO_DISPLAYS * displays = (GLINFO_DISPLAYS *) data;
+
+    displays->screens[idx] = ogliScreenCount(displays->names[idx]);
+}
+
+/* every display, screen and profile asked for in one combined report */
+int probeDisplays()
+{
+    GLINFO_DISPLAYS displays;
+    GLINFO_JOB      * jobs;
+    OGLI_CONTEXT    ** ctxs;
+    char            * name;
+    const char      * env = getenv("DISPLAY");
+    GLuint          idx, total = 0, count = 0, failed = 0, profiles = allProfiles ? OGLI_TOTAL_PROFILES : 1;
+    GLint           screen, first, last, prof;
+
+    if (displayList)
+    {
+        for (name = strtok(displayList, ","); name; name = strtok(NULL, ","))
+        {
+            if (total == GLINFO_MAX_DISPLAYS)
+                die("Too many X displays.");
+            displays.names[total++] = name;
+        }
+        if (!total)
+            die("Missing X display list.");
+    }
+    else
+        displays.names[total++] = env && *env ? env : ":0";
+
+    /* opening a display may stall on a remote host, they are counted concurrently as well */
+    if (allScreens)
+        runPool(countTask, &displays, total);
+    for (idx = 0; idx < total; idx++)
+    {
+        if (!allScreens)
+            displays.screens[idx] = 1;
+        count += displays.screens[idx] > 0 ? displays.screens[idx] * profiles : profiles;
+    }
+
+    jobs = (GLINFO_JOB *) calloc(count, sizeof(GLINFO_JOB));
+    ctxs = (OGLI_CONTEXT **) calloc(count, sizeof(OGLI_CONTEXT *));
+    if (!jobs || !ctxs)
+        die("Not enough memory.");
+
+    count = 0;
+    for (idx = 0; idx < total; idx++)
+    {
+        first = allScreens && displays.screens[idx] > 0 ? 0 : -1;
+        last = allScreens ? displays.screens[idx] - 1 : -1;
+        if (last < first)
+            last = first;
+        for (screen = first; screen <= last; screen++)
+        {
+            for (prof = 0; prof < (GLint) profiles; prof++)
+            {
+                jobs[count].ctx = ogliInit(allProfiles ? (OGLI_PROFILE) prof : profile);
+                if (!jobs[count].ctx)
+                    die("Cannot init OGLI library.");
+                jobs[count].display = displays.names[idx];
+                jobs[count].screen = screen;
+                if (!displays.screens[idx])
+                    jobs[count].error = "Cannot open X display.";
+                count++;
+            }
+        }
+    }
+
+    probeConcurrently(jobs, count);
+
+    for (idx = 0; idx < count; idx++)
+        if (jobs[idx].error)
+            failed++;
+    showReport(jobs, count, GL_TRUE);
+
+    for (idx = 0; idx < count; idx++)
+        ctxs[idx] = jobs[idx].ctx;
+    if (traceFile)
+        writeTrace(traceFile, ctxs, count);
+    for (idx = 0; idx < count; idx++)
+        ogliShutdown(ctxs[idx]);
+    free(ctxs);
+    free(jobs);
+
+    return failed == count ? -1 : 0;
+}
+
+/* renders the profiles held by the snapshot from the live driver, as JSON */
+GLboolean diffLive(const GLINFO_SNAPSHOT * before, GLINFO_SNAPSHOT * after)
+{
+    GLINFO_JOB      jobs[OGLI_TOTAL_PROFILES];
+    GLINFO_SECTIONS sections;
+    GLINFO_REPORT   report;
+    GLboolean       all;
+    GLuint          idx, count;
+
+    if (!diffLiveSetup(before, &sections, &profile, &all))
+        die("The snapshot holds no available profile.");
+    infShow = sections.info;
+    gluShow = sections.glu;
+    extShow = sections.extensions;
+    limShow = sections.limits;
+    maxVersion = sections.maxVersion;
+
+    count = all ? OGLI_TOTAL_PROFILES : 1;
+    memset(jobs, 0, sizeof(jobs));
+    for (idx = 0; idx < count; idx++)
+    {
+        jobs[idx].ctx = ogliInit(all ? (OGLI_PROFILE) idx : profile);
+        if (!jobs[idx].ctx)
+            die("Cannot init OGLI library.");
+    }
+    if (all)
+        probeConcurrently(jobs, count);
+    else if ((jobs[0].error = probe(&jobs[0])) != NULL)
+        die(jobs[0].error);
+
+    if (!reportRender(&report, GLINFO_FORMAT_JSON, &sections, jobs, count, all))
+        die("Not enough memory.");
+    for (idx = 0; idx < count; idx++)
+        ogliShutdown(jobs[idx].ctx);
+    return diffParse(after, report.data);
+}
+
+int diffSnapshots()
+{
+    GLINFO_SNAPSHOT before, after;
+    int             status;
+
+    if (!diffLoad(&before, diffBefore))
+        die("Unable to read the first snapshot, a --format=json report is expected.");
+    if (diffAfter ? !diffLoad(&after, diffAfter) : !diffLive(&before, &after))
+        die("Unable to read the second snapshot, a --format=json report is expected.");
+
+    status = diffCompare(&before, &after);
+    diffFree(&before);
+    diffFree(&after);
+    return status;
+}
+
+int main(int argc, char **argv)
+{
+    GLINFO_JOB          job;
+
+    if (!parseArgs(argc, argv))     return 0;
+    if (queryPath)                  return queryDaemon(argc, argv);
+    if (diffBefore)                 return diffSnapshots();
+    if (displayList || allScreens)  return probeDisplays();
+    if (allProfiles)                return probeAllProfiles();
+    if (watchInterval > 0)          return watchProfile();
+
+    memset(&job, 0, sizeof(GLINFO_JOB));
+    job.ctx = ogliInit(profile);
+    if (!job.ctx)                   die("Cannot init OGLI library.");
+    job.error = probe(&job);
+    if (job.error)                  die(job.error);
+    if (servePath)                  return serveProfile(&job);
+    showReport(&job, 1, GL_FALSE);
+    if (traceFile)
+        writeTrace(traceFile, &job.ctx, 1);
+    ogliShutdown(job.ctx);
 
     return  0;
 }
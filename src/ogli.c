@@ -27,31 +27,53 @@
 ** THE POSSIBILITY OF SUCH DAMAGE.
 */
 
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#   define _GNU_SOURCE          /* dladdr() */
+#endif
+
 #include <stdio.h>
+#include <stddef.h>
 #include <string.h>
 #include "ogli.h"
 
+#ifndef _WIN32
+#   include <time.h>
+#   include <pthread.h>
+#   include <dlfcn.h>
+#   include <fcntl.h>
+#   include <sys/mman.h>
+#   include <sys/stat.h>
+#   include <sys/types.h>
+#endif
+
 #define GL_SHADING_LANGUAGE_VERSION  0x8B8C
 #define GL_NUM_EXTENSIONS            0x821D
 
+#ifndef APIENTRY
+#   define APIENTRY
+#endif /* APIENTRY */
+
+/* phase markers, evaluated only when the context is timed */
+#define OGLI_BEGIN(ctx, phase)  do { if ((ctx)->timed) ogliBeginPhase(ctx, phase); } while (0)
+#define OGLI_END(ctx, phase)    do { if ((ctx)->timed) ogliEndPhase(ctx, phase); } while (0)
+
+/* entry points needed by the limits query, under private names to work with every header set */
+typedef void (APIENTRY * OGLI_GETINTEGERI_PROC) (GLenum target, GLuint index, GLint *data);
+typedef void (APIENTRY * OGLI_GETINTERNALFORMAT_PROC) (GLenum target, GLenum format, GLenum pname, GLsizei size, GLint *params);
+
 /*------------------------------------------------------------------------------------------------*/
 /*                         PORTIONS ARE FROM GLEXT.H AND WGLEXT.H                                 */
 /*------------------------------------------------------------------------------------------------*/
 #ifndef __APPLE__
 #   ifndef OGLI_USE_GLEW
-#       ifndef APIENTRY
-#           define APIENTRY
-#       endif /* APIENTRY */
         typedef const GLubyte *(APIENTRY *  PFNGLGETSTRINGIPROC) (GLenum name, GLuint index); 
-        PFNGLGETSTRINGIPROC glGetStringi = NULL;
 #       ifdef _WIN32
             typedef HGLRC (WINAPI * PFNWGLCREATECONTEXTATTRIBSARBPROC) (HDC hDC, HGLRC hShareContext, const int *attribList); 
-            PFNWGLCREATECONTEXTATTRIBSARBPROC wglCreateContextAttribsARB = NULL;
 #       endif /* _WIN32 */
 #   endif /* OGLI_USE_GLEW */
 #endif /* __APPLE__ */
 
-void ogliLog(const char * msg)
+static void ogliLog(const char * msg)
 {
 #ifdef OGLI_DEBUG
     fprintf(stderr, "%s\n", msg);
@@ -84,29 +106,224 @@ static GLboolean checkExtension(const char *extList, const char *extension)
     return GL_FALSE;
 }
 
+/* FNV-1a hash of an extension name */
+static GLuint ogliHashName(const char * name, GLuint length)
+{
+    GLuint hash = 2166136261u;
+
+    while (length--)
+    {
+        hash ^= (GLubyte) *name++;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+static void ogliExtListFree(OGLI_EXT_LIST * list)
+{
+    free(list->offsets);    /* names live in the same allocation */
+    memset(list, 0, sizeof(OGLI_EXT_LIST));
+}
+
+/* allocates the offsets table and the names in a single block, 'bytes' accounts for 
+   each name plus its separator */
+static GLboolean ogliExtListAlloc(OGLI_EXT_LIST * list, GLuint count, GLuint bytes)
+{
+    ogliExtListFree(list);
+
+    list->offsets = (GLuint *) malloc((count + 1) * sizeof(GLuint) + bytes + 1);
+    if (!list->offsets)
+    {
+        ogliLog("ogliExtListAlloc: Not enough memory for extension list");
+        return GL_FALSE;
+    }
+
+    list->names = (char *) (list->offsets + count + 1);
+    list->names[0] = '\0';
+    list->offsets[0] = 0;
+    return GL_TRUE;
+}
+
+/* appends a name at the tail of the list, returns the new tail */
+static char * ogliExtListAppend(OGLI_EXT_LIST * list, char * tail, const char * name, GLuint length)
+{
+    if (list->count)
+        *tail++ = ' ';
+    memcpy(tail, name, length);
+    tail += length;
+    *tail = '\0';
+
+    list->count++;
+    list->offsets[list->count] = (GLuint) (tail - list->names) + 1;
+    list->size = (GLuint) (tail - list->names) + 1;
+    return tail;
+}
+
+/* splits a space separated extension string into a list, extra separators are dropped */
+static GLboolean ogliExtListParse(OGLI_EXT_LIST * list, const char * extString)
+{
+    const char  * name;
+    char        * tail;
+    GLuint      count = 0, length;
+
+    if (!extString)
+        extString = "";
+
+    for (name = extString; *name; name++)
+    {
+        if (*name != ' ' && (name == extString || *(name - 1) == ' '))
+            count++;
+    }
+
+    if (!ogliExtListAlloc(list, count, (GLuint) strlen(extString) + 1))
+        return GL_FALSE;
+
+    for (name = extString, tail = list->names; *name; name += length)
+    {
+        if (*name == ' ')
+        {
+            length = 1;
+            continue;
+        }
+
+        for (length = 0; name[length] && name[length] != ' '; length++);
+        tail = ogliExtListAppend(list, tail, name, length);
+    }
+    return GL_TRUE;
+}
+
+static void ogliIndexFree(OGLI_EXT_INDEX * index)
+{
+    free(index->slots);
+    index->slots = NULL;
+    index->capacity = 0;
+    index->count = 0;
+}
+
+/* builds the hash set over an extension list, the list must outlive the index */
+static GLboolean ogliIndexBuild(OGLI_EXT_INDEX * index, const OGLI_EXT_LIST * list)
+{
+    const char  * name;
+    GLuint      idx, length, hash, slot;
+
+    ogliIndexFree(index);
+
+    /* size the table to keep the load factor at or below 50% */
+    for (index->capacity = 16; index->capacity < list->count * 2; index->capacity <<= 1);
+
+    index->slots = (OGLI_EXT_INDEX_SLOT *) calloc(index->capacity, sizeof(OGLI_EXT_INDEX_SLOT));
+    if (!index->slots)
+    {
+        ogliLog("ogliIndexBuild: Not enough memory for extension index");
+        index->capacity = 0;
+        return GL_FALSE;
+    }
+
+    for (idx = 0; idx < list->count; idx++)
+    {
+        name = list->names + list->offsets[idx];
+        length = list->offsets[idx + 1] - list->offsets[idx] - 1;
+        hash = ogliHashName(name, length);
+
+        /* linear probing, duplicated names are stored only once */
+        for (slot = hash & (index->capacity - 1); index->slots[slot].name; slot = (slot + 1) & (index->capacity - 1))
+        {
+            if (index->slots[slot].hash == hash && index->slots[slot].length == length &&
+                memcmp(index->slots[slot].name, name, length) == 0)
+                break;
+        }
+
+        if (!index->slots[slot].name)
+        {
+            index->slots[slot].name = name;
+            index->slots[slot].length = length;
+            index->slots[slot].hash = hash;
+            index->count++;
+        }
+    }
+    return GL_TRUE;
+}
+
+static GLboolean ogliIndexFind(const OGLI_EXT_INDEX * index, const char * extension)
+{
+    GLuint length, hash, slot;
+
+    if (!index->slots)
+        return GL_FALSE;
+
+    length = (GLuint) strlen(extension);
+    hash = ogliHashName(extension, length);
+    for (slot = hash & (index->capacity - 1); index->slots[slot].name; slot = (slot + 1) & (index->capacity - 1))
+    {
+        if (index->slots[slot].hash == hash && index->slots[slot].length == length &&
+            memcmp(index->slots[slot].name, extension, length) == 0)
+            return GL_TRUE;
+    }
+    return GL_FALSE;
+}
+
+double ogliNow()
+{
+#ifdef _WIN32
+    LARGE_INTEGER freq, now;
+
+    QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&now);
+    return (double) now.QuadPart / (double) freq.QuadPart;
+#else
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec * 1e-9;
+#endif
+}
+
+static void ogliBeginPhase(OGLI_CONTEXT * ctx, OGLI_PHASE phase)
+{
+    ctx->phaseEntry[phase] = ogliNow() - ctx->timeBase;
+}
+
+/* a phase left by an error return is never ended, hence never counted */
+static void ogliEndPhase(OGLI_CONTEXT * ctx, OGLI_PHASE phase)
+{
+    OGLI_TIMING * timing = &ctx->timings[phase];
+
+    if (!timing->count)
+        timing->start = ctx->phaseEntry[phase];
+    timing->duration += ogliNow() - ctx->timeBase - ctx->phaseEntry[phase];
+    timing->count++;
+}
+
 #ifndef OGLI_USE_GLEW
 #   ifdef  _WIN32
-#       define ogliGetProcAddress(name)  wglGetProcAddress((const char *) name)
+#       define ogliGetProcAddress(ctx, name)  wglGetProcAddress((const char *) name)
 #   elif __APPLE__
         /* since OSX has already initialized OpenGL extensions, there's nothing to do here */
 #   else /* LINUX */
-#       define ogliGetProcAddress(name)  glXGetProcAddressARB((const char *) name)
+#       ifdef OGLI_USE_EGL
+#           define ogliGetProcAddress(ctx, name)  ((ctx)->backend == OGLI_BACKEND_EGL ?                   \
+                                                   (void (*)(void)) eglGetProcAddress((const char *) name) : \
+                                                   (void (*)(void)) glXGetProcAddressARB((const GLubyte *) name))
+#       else
+#           define ogliGetProcAddress(ctx, name)  glXGetProcAddressARB((const GLubyte *) name)
+#       endif /* OGLI_USE_EGL */
 #   endif /* LINUX */
 #endif /* OGLI_USE_GLEW */
 
-static GLboolean ogliInitCore()
+static GLboolean ogliInitCore(OGLI_CONTEXT * ctx)
 {
+    OGLI_BEGIN(ctx, OGLI_PHASE_INIT_CORE);
 #ifndef __APPLE__
 #   ifndef OGLI_USE_GLEW
-        glGetStringi = (PFNGLGETSTRINGIPROC) ogliGetProcAddress((const char *) "glGetStringi");
-        if (!glGetStringi)
+        ctx->getStringi = (PFNGLGETSTRINGIPROC) ogliGetProcAddress(ctx, "glGetStringi");
+        if (!ctx->getStringi)
         {
             ogliLog("ogliInitCore: Failed to obtain glGetStringi()");
             return GL_FALSE;
         }
         #ifdef  _WIN32
-            wglCreateContextAttribsARB = (PFNWGLCREATECONTEXTATTRIBSARBPROC) ogliGetProcAddress((GLubyte *) "wglCreateContextAttribsARB");
-            if (!wglCreateContextAttribsARB)
+            ctx->createContextAttribs = (PFNWGLCREATECONTEXTATTRIBSARBPROC) ogliGetProcAddress(ctx, "wglCreateContextAttribsARB");
+            if (!ctx->createContextAttribs)
             {
                 ogliLog("ogliInitCore: Failed to obtain wglCreateContextAttribsARB()");
                 return GL_FALSE;
@@ -120,16 +337,188 @@ static GLboolean ogliInitCore()
             ogliLog("ogliInitCore: Failed to init GLEW library");
             return GL_FALSE;
         }
+        ctx->getStringi = glGetStringi;
 #   endif /* OGLI_USE_GLEW */
+#else
+    ctx->getStringi = glGetStringi;
 #endif  /* __APPLE__ */
+    OGLI_END(ctx, OGLI_PHASE_INIT_CORE);
+    return GL_TRUE;
+}
+
+OGLI_PROC ogliGetProc(const OGLI_CONTEXT * ctx, const char * name)
+{
+    if (!ctx || !ctx->active || !name)
+        return NULL;
+
+#ifdef _WIN32
+    return (OGLI_PROC) wglGetProcAddress(name);
+#elif __APPLE__
+    return (OGLI_PROC) dlsym(RTLD_DEFAULT, name);
+#else
+#   ifdef OGLI_USE_EGL
+    if (ctx->backend == OGLI_BACKEND_EGL)
+        return (OGLI_PROC) eglGetProcAddress(name);
+#   endif /* OGLI_USE_EGL */
+    return (OGLI_PROC) glXGetProcAddressARB((const GLubyte *) name);
+#endif
+}
+
+const char * ogliProfileName(OGLI_PROFILE profile)
+{
+    static const char * names[OGLI_TOTAL_PROFILES] = {"legacy", "core", "compat", "forward"};
+
+    return (unsigned) profile < OGLI_TOTAL_PROFILES ? names[profile] : "unknown";
+}
+
+/* attributes shared by WGL_ARB_create_context and GLX_ARB_create_context */
+#define OGLI_CONTEXT_MAJOR_VERSION          0x2091
+#define OGLI_CONTEXT_MINOR_VERSION          0x2092
+#define OGLI_CONTEXT_FLAGS                  0x2094
+#define OGLI_CONTEXT_PROFILE_MASK           0x9126
+#define OGLI_CONTEXT_CORE_PROFILE_BIT       0x0001
+#define OGLI_CONTEXT_COMPAT_PROFILE_BIT     0x0002
+#define OGLI_CONTEXT_FORWARD_COMPATIBLE_BIT 0x0002
+
+/* fills a zero-terminated WGL/GLX attribute list for the given profile and version */
+static void ogliContextAttribs(OGLI_PROFILE profile, int major, int minor, int * attribs)
+{
+    int idx = 0;
+
+    attribs[idx++] = OGLI_CONTEXT_MAJOR_VERSION;
+    attribs[idx++] = major;
+    attribs[idx++] = OGLI_CONTEXT_MINOR_VERSION;
+    attribs[idx++] = minor;
+    attribs[idx++] = OGLI_CONTEXT_PROFILE_MASK;
+    attribs[idx++] = profile == OGLI_COMPAT ? OGLI_CONTEXT_COMPAT_PROFILE_BIT : OGLI_CONTEXT_CORE_PROFILE_BIT;
+    if (profile == OGLI_FORWARD)
+    {
+        attribs[idx++] = OGLI_CONTEXT_FLAGS;
+        attribs[idx++] = OGLI_CONTEXT_FORWARD_COMPATIBLE_BIT;
+    }
+    attribs[idx] = 0;
+}
+
+/* framebuffer config attribute of the window system and the field it is stored into */
+typedef struct fbconfig_attrib
+{
+    int     attrib;
+    size_t  offset;
+} OGLI_FBCONFIG_ATTRIB;
+
+#define OGLI_FBCONFIG_FIELD(config, attrib)     ((GLint *) ((char *) (config) + (attrib)->offset))
+
+/* (re)allocates the config list of the context */
+static OGLI_FBCONFIG * ogliAllocFBConfigs(OGLI_CONTEXT * ctx, GLuint count)
+{
+    free(ctx->fbconfigs);
+    ctx->totalFBConfigs = 0;
+    ctx->fbconfigs = (OGLI_FBCONFIG *) calloc(count ? count : 1, sizeof(OGLI_FBCONFIG));
+    if (!ctx->fbconfigs)
+        ogliLog("ogliQueryFBConfigs: Not enough memory for configs");
+    return ctx->fbconfigs;
+}
+
+/* context versions that can be requested with a profile, in ascending order */
+static const OGLI_GL_VERSION_BLOCK ogliVersionLadder[] =
+{
+    {3, 2, 0}, {3, 3, 0}, {4, 0, 0}, {4, 1, 0}, {4, 2, 0}, {4, 3, 0}, {4, 4, 0}, {4, 5, 0}, {4, 6, 0}
+};
+#define OGLI_TOTAL_VERSIONS (sizeof(ogliVersionLadder) / sizeof(ogliVersionLadder[0]))
+
+/* platform specific, creates and destroys a context of the given profile and version */
+static GLboolean ogliProbeVersion(OGLI_CONTEXT * ctx, OGLI_PROFILE profile, int major, int minor);
+
+/* 
+** Highest version of the ladder that can be created for a profile. A driver able to create a 
+** version can create every lower one, so the top rung is tried first (the answer of current
+** drivers) and a binary search over the rest follows: at most 4 more probes instead of 8.
+*/
+static void ogliSearchVersion(OGLI_CONTEXT * ctx, OGLI_PROFILE profile, OGLI_GL_VERSION_BLOCK * found)
+{
+    int lo = 0, hi = OGLI_TOTAL_VERSIONS - 1, mid, best = -1;
+
+    if (ogliProbeVersion(ctx, profile, ogliVersionLadder[hi].major, ogliVersionLadder[hi].minor))
+        best = hi;
+    else
+    {
+        for (hi--; lo <= hi; )
+        {
+            mid = (lo + hi) / 2;
+            if (ogliProbeVersion(ctx, profile, ogliVersionLadder[mid].major, ogliVersionLadder[mid].minor))
+                best = mid, lo = mid + 1;
+            else
+                hi = mid - 1;
+        }
+    }
+
+    if (best >= 0)
+        *found = ogliVersionLadder[best];
+    else
+        memset(found, 0, sizeof(OGLI_GL_VERSION_BLOCK));
+}
+
+GLboolean ogliDiscoverVersions(OGLI_CONTEXT * ctx)
+{
+    if (!ctx)
+    {
+        ogliLog("ogliDiscoverVersions: Invalid OGLI context");
+        return GL_FALSE;
+    }
+
+    if (!ctx->active)
+    {
+        ogliLog("ogliDiscoverVersions: OGLI is not ready");
+        return GL_FALSE;
+    }
+
+    ogliSearchVersion(ctx, OGLI_CORE, &ctx->iblock.maxCore);
+    ogliSearchVersion(ctx, OGLI_COMPAT, &ctx->iblock.maxCompat);
     return GL_TRUE;
 }
 
+#ifdef __linux__
+static GLboolean ogliQueryRendererGLX(OGLI_CONTEXT * ctx);
+#endif /* __linux__ */
+
+GLboolean ogliQueryRenderer(OGLI_CONTEXT * ctx)
+{
+    if (!ctx)
+    {
+        ogliLog("ogliQueryRenderer: Invalid OGLI context");
+        return GL_FALSE;
+    }
+
+    /* the strings of an active context win over the ones of the display */
+    if (ctx->active && !ogliQueryEx(ctx, OGLI_Q_BASIC))
+        return GL_FALSE;
+
+    memset(&ctx->iblock.renderer, 0, sizeof(OGLI_RENDERER));
+#ifdef __linux__
+    /* EGL has no such query, the GL strings of a context are all there is */
+    if (ctx->backend == OGLI_BACKEND_NATIVE)
+        return ogliQueryRendererGLX(ctx);
+#endif /* __linux__ */
+    return GL_FALSE;
+}
+
+const char * ogliRendererSourceName(OGLI_RENDERER_SOURCE source)
+{
+    static const char * names[] = {"none", "display", "context"};
+
+    return (unsigned) source <= OGLI_RENDERER_CONTEXT ? names[source] : "unknown";
+}
+
 GLuint ogliGetVersion()
 {
     return  (OGLI_MAJOR_VERSION << 8 | OGLI_MINOR_VERSION);
 }
 
+#ifdef __linux__
+static void ogliInitXlib(void);
+static pthread_once_t xlibOnce = PTHREAD_ONCE_INIT;
+#endif /* __linux__ */
+
 OGLI_CONTEXT * ogliInit(OGLI_PROFILE profile)
 {
     OGLI_CONTEXT * ctx = (OGLI_CONTEXT *) malloc(sizeof(OGLI_CONTEXT));
@@ -140,6 +529,18 @@ OGLI_CONTEXT * ogliInit(OGLI_PROFILE profile)
     }
 
     ctx->profile = profile;
+    ctx->backend = OGLI_BACKEND_NATIVE;
+    ctx->windowless = GL_FALSE;
+    ctx->timed = GL_FALSE;
+    ctx->timeBase = 0;
+    memset(ctx->timings, 0, sizeof(ctx->timings));
+    ctx->fbconfigs = NULL;
+    ctx->totalFBConfigs = 0;
+    ctx->pool = NULL;
+    ctx->getStringi = NULL;
+#ifndef __APPLE__
+    ctx->createContextAttribs = NULL;
+#endif /* __APPLE__ */
 
 #ifdef _WIN32
     ctx->wnd = NULL;
@@ -152,523 +553,2926 @@ OGLI_CONTEXT * ogliInit(OGLI_PROFILE profile)
     ctx->contextOrig = NULL;
 #endif /* __APPLE__ */
 
-#ifdef __GLX__
-#endif /* __GLX__ */
+#ifdef __linux__
+    pthread_once(&xlibOnce, ogliInitXlib);
+    ctx->context = 0;
+    ctx->display = NULL;
+    ctx->cmap = 0;
+    ctx->win = 0;
+    ctx->pbuffer = 0;
+    ctx->displayName[0] = 0;
+    ctx->screen = -1;
+    ctx->drawable = OGLI_DRAWABLE_WINDOW;
+    ctx->errorOccurred = GL_FALSE;
+    ctx->nextTrap = NULL;
+#   ifdef OGLI_USE_EGL
+    ctx->eglDisplay = EGL_NO_DISPLAY;
+    ctx->eglContext = EGL_NO_CONTEXT;
+#   endif /* OGLI_USE_EGL */
+#endif /* __linux__ */
 
     ctx->active = GL_FALSE;
     memset(&ctx->iblock, 0, sizeof(GL_INFO_BLOCK));
+    memset(&ctx->extIndex, 0, sizeof(OGLI_EXT_INDEX));
     return ctx;
 }
 
-GLboolean ogliShutdown(OGLI_CONTEXT * ctx)
+GLboolean ogliSetBackend(OGLI_CONTEXT * ctx, OGLI_BACKEND backend)
 {
     if (!ctx)
+    {
+        ogliLog("ogliSetBackend: Invalid OGLI context");
         return GL_FALSE;
-  
+    }
+
     if (ctx->active)
     {
-        if (!ogliDestroyContext(ctx))
-            return GL_FALSE;
+        ogliLog("ogliSetBackend: Context has already been created");
+        return GL_FALSE;
     }
 
-    free(ctx);
+#if !defined(__linux__) || !defined(OGLI_USE_EGL)
+    if (backend == OGLI_BACKEND_EGL)
+    {
+        ogliLog("ogliSetBackend: EGL backend is not available in this build");
+        return GL_FALSE;
+    }
+#endif
+
+    ctx->backend = backend;
     return GL_TRUE;
 }
 
-GLboolean ogliSupported(OGLI_CONTEXT * ctx, const char *extension)
+GLboolean ogliSetWindowless(OGLI_CONTEXT * ctx, GLboolean windowless)
 {
     if (!ctx)
     {
-        ogliLog("ogliSupported: Invalid OGLI context");
+        ogliLog("ogliSetWindowless: Invalid OGLI context");
         return GL_FALSE;
     }
 
-    if (!ctx->active)
+    if (ctx->active)
     {
-        ogliLog("ogliSupported: OGLI is not ready");
+        ogliLog("ogliSetWindowless: Context has already been created");
         return GL_FALSE;
     }
 
-    /* at this point of initialization, it is assumed that both 
-       legacy and core profiles are supported */
-    return checkExtension(ctx->iblock.glExtensions, extension);
+    ctx->windowless = windowless;
+    return GL_TRUE;
 }
 
-GLboolean ogliQuery(OGLI_CONTEXT * ctx)
+/* only the native Linux backend has displays to choose from */
+GLboolean ogliSetDisplay(OGLI_CONTEXT * ctx, const char * display, GLint screen)
 {
-    char *  glsl, * ext, * tmp;
-    GLint numExts, idx;
-
     if (!ctx)
     {
-        ogliLog("ogliQuery: Invalid OGLI context");
+        ogliLog("ogliSetDisplay: Invalid OGLI context");
         return GL_FALSE;
     }
 
-    if (!ctx->active)
+    if (ctx->active)
     {
-        ogliLog("ogliQuery: OGLI is not ready");
+        ogliLog("ogliSetDisplay: Context has already been created");
         return GL_FALSE;
     }
 
-    /* reads the basic OpenGL information and store them into our information block */
-    strncpy((char *) ctx->iblock.glRenderer,  (char *) glGetString(GL_RENDERER), OGLI_MAX_INFO_LENGTH-1);
-    strncpy((char *) ctx->iblock.glVendor,    (char *) glGetString(GL_VENDOR), OGLI_MAX_INFO_LENGTH-1);
-    strncpy((char *) ctx->iblock.glVersion,   (char *) glGetString(GL_VERSION), OGLI_MAX_INFO_LENGTH-1);
-
-    /* extracts the OpenGL version number */
-    sscanf(ctx->iblock.glVersion, "%d.%d.%d", &ctx->iblock.versionGL.major, 
-                                              &ctx->iblock.versionGL.minor,
-                                              &ctx->iblock.versionGL.release);
-
-    /* GLSL only present from OpenGL 2.0+ */
-    if (ctx->iblock.versionGL.major >= 2)
+#ifdef __linux__
+    if (display && strlen(display) >= OGLI_MAX_INFO_LENGTH)
     {
-        /* double check :) */
-        glsl = (char *) glGetString(GL_SHADING_LANGUAGE_VERSION); 
-        if (!glsl)
-            strcpy((char *) ctx->iblock.glSL, "None");
-        else
-        {
-            strcpy((char *) ctx->iblock.glSL, glsl);
-            /* extracts the GLSL version number */
-            sscanf(ctx->iblock.glSL, "%d.%d", &ctx->iblock.versionGLSL.major, &ctx->iblock.versionGLSL.minor);
-        }
+        ogliLog("ogliSetDisplay: Display name is too long");
+        return GL_FALSE;
     }
-    else
-        strcpy((char *) ctx->iblock.glSL, "None");
+    strcpy(ctx->displayName, display ? display : "");
+    ctx->screen = screen < 0 ? -1 : screen;
+    return GL_TRUE;
+#else
+    if (!display && screen < 0)
+        return GL_TRUE;
+    ogliLog("ogliSetDisplay: Displays can only be selected on Linux");
+    return GL_FALSE;
+#endif /* __linux__ */
+}
 
-    /* stores the extensions list for later use */ 
-#ifndef __APPLE__
-    if (ctx->profile == OGLI_LEGACY ||                          /* use legacy profile */
-        (ctx->profile == OGLI_CORE && glGetStringi == NULL))    /* or error while init core profile */
+/* number of screens of a display, 0 when it cannot be opened */
+GLint ogliScreenCount(const char * display)
+{
+#ifdef __linux__
+    Display * dpy;
+    GLint     count;
+
+    pthread_once(&xlibOnce, ogliInitXlib);
+    dpy = XOpenDisplay(display);
+    if (!dpy)
+        return 0;
+    count = ScreenCount(dpy);
+    XCloseDisplay(dpy);
+    return count;
 #else
-    if (ctx->profile == OGLI_LEGACY)
-#endif
-    {
-        /* copy the extensions string */
-        ext = (char *) glGetString(GL_EXTENSIONS);
-        if (ext)
-            strcpy((char *) ctx->iblock.glExtensions, ext);
-        else
-            strcpy((char *) ctx->iblock.glExtensions, "");
+    return 1;
+#endif /* __linux__ */
+}
 
-        /* simplest way to count the number of extensions */
-        for (tmp = ctx->iblock.glExtensions; *tmp; tmp++)
-        {
-            if (*tmp == ' ')
-                ctx->iblock.totalExtensions++;
-        }
-    }
-    else
+GLboolean ogliSetTimings(OGLI_CONTEXT * ctx, GLboolean enable)
+{
+    if (!ctx)
     {
-        /* form an extenion string just like the legacy one */
-        glGetIntegerv(GL_NUM_EXTENSIONS, &numExts);
-        ctx->iblock.totalExtensions = numExts;
-        for (idx = 0; idx < numExts; idx++) 
-        {
-            strcat(ctx->iblock.glExtensions, (char *) glGetStringi(GL_EXTENSIONS, idx));
-            strcat(ctx->iblock.glExtensions, " ");
-        }
+        ogliLog("ogliSetTimings: Invalid OGLI context");
+        return GL_FALSE;
     }
 
-    /* OpenGL Utility Library */
-    strcpy((char *) ctx->iblock.gluVersion,   (char *) gluGetString(GLU_VERSION));
-    ext = (char *) gluGetString(GLU_EXTENSIONS);
-    if (ext)
-        strcpy((char *) ctx->iblock.gluExtensions, ext);
-    else
-        strcpy((char *) ctx->iblock.gluExtensions, "");
-
-    return GL_TRUE; 
+    ctx->timed = enable;
+    ctx->timeBase = ogliNow();
+    memset(ctx->timings, 0, sizeof(ctx->timings));
+    return GL_TRUE;
 }
 
-/*------------------------------------------------------------------------------------------------*/
-/*                                WIN32 PLATFORM SPECIFIC CODE                                    */
-/*------------------------------------------------------------------------------------------------*/
-#ifdef  _WIN32
-
-/* class name and window's title */
-static char * g_WNDCLASS = "LIBOGLI";
+const OGLI_TIMING * ogliGetTimings(const OGLI_CONTEXT * ctx)
+{
+    return ctx ? ctx->timings : NULL;
+}
 
-GLboolean ogliCreateContext(OGLI_CONTEXT * ctx)
+const char * ogliPhaseName(OGLI_PHASE phase)
+{
+    static const char * names[OGLI_TOTAL_PHASES] = 
+    {
+        "display", "config", "context", "current", "init core", "query", "limits", "glu", "destroy", "cache"
+    };
+
+    return (unsigned) phase < OGLI_TOTAL_PHASES ? names[phase] : "unknown";
+}
+
+GLboolean ogliShutdown(OGLI_CONTEXT * ctx)
+{
+    if (!ctx)
+        return GL_FALSE;
+  
+    if (ctx->active)
+    {
+        if (!ogliDestroyContext(ctx))
+            return GL_FALSE;
+    }
+
+    ogliIndexFree(&ctx->extIndex);
+    ogliExtListFree(&ctx->iblock.glExtensions);
+    ogliExtListFree(&ctx->iblock.gluExtensions);
+    free(ctx->fbconfigs);
+    free(ctx);
+    return GL_TRUE;
+}
+
+static GLboolean ogliBindContext(OGLI_CONTEXT * ctx, GLboolean bind);
+#ifdef __linux__
+static void ogliPoolAdopt(OGLI_POOL * pool, OGLI_CONTEXT * ctx);
+static void ogliPoolClose(OGLI_POOL * pool);
+#endif /* __linux__ */
+
+OGLI_POOL * ogliPoolCreate(OGLI_BACKEND backend, GLboolean windowless)
+{
+    OGLI_POOL * pool;
+
+#if !defined(__linux__) || !defined(OGLI_USE_EGL)
+    if (backend == OGLI_BACKEND_EGL)
+    {
+        ogliLog("ogliPoolCreate: EGL backend is not available in this build");
+        return NULL;
+    }
+#endif
+
+    pool = (OGLI_POOL *) calloc(1, sizeof(OGLI_POOL));
+    if (!pool)
+    {
+        ogliLog("ogliPoolCreate: Not enough memory for pool");
+        return NULL;
+    }
+
+    pool->backend = backend;
+    pool->windowless = windowless;
+#if defined(__linux__) && defined(OGLI_USE_EGL)
+    pool->eglDisplay = EGL_NO_DISPLAY;
+#endif
+    return pool;
+}
+
+OGLI_CONTEXT * ogliPoolAcquire(OGLI_POOL * pool, OGLI_PROFILE profile, GLboolean fresh)
+{
+    OGLI_CONTEXT * ctx;
+
+    if (!pool || (unsigned) profile >= OGLI_TOTAL_PROFILES)
+    {
+        ogliLog("ogliPoolAcquire: Invalid OGLI pool or profile");
+        return NULL;
+    }
+
+    /* an idle context only has to be made current again */
+    while (!fresh && pool->idleCount[profile])
+    {
+        ctx = pool->idle[profile][--pool->idleCount[profile]];
+        if (ogliBindContext(ctx, GL_TRUE))
+        {
+            pool->reused++;
+            pool->outstanding++;
+            return ctx;
+        }
+        ogliShutdown(ctx);
+    }
+
+    ctx = ogliInit(profile);
+    if (!ctx)
+        return NULL;
+
+    ctx->pool = pool;
+    if (!ogliSetBackend(ctx, pool->backend) || !ogliSetWindowless(ctx, pool->windowless) || 
+        !ogliCreateContext(ctx))
+    {
+        ogliShutdown(ctx);
+        return NULL;
+    }
+#ifdef __linux__
+    ogliPoolAdopt(pool, ctx);
+#endif /* __linux__ */
+    pool->created++;
+    pool->outstanding++;
+    return ctx;
+}
+
+GLboolean ogliPoolRelease(OGLI_POOL * pool, OGLI_CONTEXT * ctx)
+{
+    GLuint * count;
+
+    if (!pool || !ctx || ctx->pool != pool || !ctx->active || !pool->outstanding)
+    {
+        ogliLog("ogliPoolRelease: Context is not an active context of the pool");
+        return GL_FALSE;
+    }
+
+    pool->outstanding--;
+    count = &pool->idleCount[ctx->profile];
+    if (*count < OGLI_POOL_IDLE && ogliBindContext(ctx, GL_FALSE))
+    {
+        pool->idle[ctx->profile][(*count)++] = ctx;
+        return GL_TRUE;
+    }
+    return ogliShutdown(ctx);
+}
+
+GLboolean ogliPoolDestroy(OGLI_POOL * pool)
+{
+    GLuint profile;
+
+    if (!pool)
+    {
+        ogliLog("ogliPoolDestroy: Invalid OGLI pool");
+        return GL_FALSE;
+    }
+
+    /* an acquired context would be left on a closed display */
+    if (pool->outstanding)
+    {
+        ogliLog("ogliPoolDestroy: Contexts of the pool are still acquired");
+        return GL_FALSE;
+    }
+
+    for (profile = 0; profile < OGLI_TOTAL_PROFILES; profile++)
+    {
+        while (pool->idleCount[profile])
+            ogliShutdown(pool->idle[profile][--pool->idleCount[profile]]);
+    }
+#ifdef __linux__
+    ogliPoolClose(pool);
+#endif /* __linux__ */
+    free(pool);
+    return GL_TRUE;
+}
+
+GLboolean ogliSupported(OGLI_CONTEXT * ctx, const char *extension)
+{
+    if (!ctx)
+    {
+        ogliLog("ogliSupported: Invalid OGLI context");
+        return GL_FALSE;
+    }
+
+    /* fetched on first use while the context is alive */
+    if (!(ctx->queried & OGLI_Q_EXTENSIONS) && ctx->active)
+        ogliQueryEx(ctx, OGLI_Q_EXTENSIONS);
+
+    if (!ctx->extIndex.slots)
+    {
+        ogliLog("ogliSupported: Extensions have not been queried");
+        return GL_FALSE;
+    }
+
+    /* at this point of initialization, it is assumed that both 
+       legacy and core profiles are supported */
+    return ogliIndexFind(&ctx->extIndex, extension);
+}
+
+GLuint ogliSupportedMany(OGLI_CONTEXT * ctx, const char ** extensions, GLuint count, GLboolean * results)
+{
+    GLuint idx, total = 0;
+
+    if (!ctx || !extensions || !results)
+    {
+        ogliLog("ogliSupportedMany: Invalid parameters");
+        return 0;
+    }
+
+    if (!(ctx->queried & OGLI_Q_EXTENSIONS) && ctx->active)
+        ogliQueryEx(ctx, OGLI_Q_EXTENSIONS);
+
+    if (!ctx->extIndex.slots)
+    {
+        ogliLog("ogliSupportedMany: Extensions have not been queried");
+        memset(results, 0, count * sizeof(GLboolean));
+        return 0;
+    }
+
+    for (idx = 0; idx < count; idx++)
+    {
+        results[idx] = extensions[idx] ? ogliIndexFind(&ctx->extIndex, extensions[idx]) : GL_FALSE;
+        total += results[idx];
+    }
+    return total;
+}
+
+/*
+** Implementation limits table. Each entry is only queried when the context version or the 
+** listed extension provides it, so no invalid enum is ever issued. Legacy entries are only 
+** queried outside of the core profile.
+*/
+#define OGLI_LIMIT_LEGACY   0x01    /* fixed function limit */
+#define OGLI_LIMIT_INT64    0x02    /* 64-bit limit, read by glGetInteger64v() */
+#define OGLI_LIMIT_INDEXED  0x04    /* one value per index, read by glGetIntegeri_v() */
+
+typedef struct limit_desc
+{
+    GLenum      pname;
+    const char  * name;
+    GLubyte     count;      /* number of values */
+    GLubyte     flags;
+    GLubyte     major;      /* OpenGL version the limit became core in */
+    GLubyte     minor;
+    const char  * extension;/* extension that provides the limit on older versions */
+} OGLI_LIMIT_DESC;
+
+static const OGLI_LIMIT_DESC ogliLimits[] =
+{
+    {0x0D33, "GL_MAX_TEXTURE_SIZE",                    1, 0,                  1, 0, NULL},
+    {0x0D3A, "GL_MAX_VIEWPORT_DIMS",                   2, 0,                  1, 0, NULL},
+    {0x8073, "GL_MAX_3D_TEXTURE_SIZE",                 1, 0,                  1, 2, "GL_EXT_texture3D"},
+    {0x851C, "GL_MAX_CUBE_MAP_TEXTURE_SIZE",           1, 0,                  1, 3, "GL_ARB_texture_cube_map"},
+    {0x80E8, "GL_MAX_ELEMENTS_VERTICES",               1, 0,                  1, 2, "GL_EXT_draw_range_elements"},
+    {0x80E9, "GL_MAX_ELEMENTS_INDICES",                1, 0,                  1, 2, "GL_EXT_draw_range_elements"},
+    {0x0D31, "GL_MAX_LIGHTS",                          1, OGLI_LIMIT_LEGACY,  1, 0, NULL},
+    {0x0D32, "GL_MAX_CLIP_PLANES",                     1, OGLI_LIMIT_LEGACY,  1, 0, NULL},
+    {0x0D36, "GL_MAX_MODELVIEW_STACK_DEPTH",           1, OGLI_LIMIT_LEGACY,  1, 0, NULL},
+    {0x84E2, "GL_MAX_TEXTURE_UNITS",                   1, OGLI_LIMIT_LEGACY,  1, 3, "GL_ARB_multitexture"},
+    {0x8824, "GL_MAX_DRAW_BUFFERS",                    1, 0,                  2, 0, "GL_ARB_draw_buffers"},
+    {0x8869, "GL_MAX_VERTEX_ATTRIBS",                  1, 0,                  2, 0, "GL_ARB_vertex_shader"},
+    {0x8872, "GL_MAX_TEXTURE_IMAGE_UNITS",             1, 0,                  2, 0, "GL_ARB_fragment_shader"},
+    {0x8B4C, "GL_MAX_VERTEX_TEXTURE_IMAGE_UNITS",      1, 0,                  2, 0, "GL_ARB_vertex_shader"},
+    {0x8B4D, "GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS",    1, 0,                  2, 0, "GL_ARB_vertex_shader"},
+    {0x8B4A, "GL_MAX_VERTEX_UNIFORM_COMPONENTS",       1, 0,                  2, 0, "GL_ARB_vertex_shader"},
+    {0x8B49, "GL_MAX_FRAGMENT_UNIFORM_COMPONENTS",     1, 0,                  2, 0, "GL_ARB_fragment_shader"},
+    {0x8B4B, "GL_MAX_VARYING_COMPONENTS",              1, 0,                  3, 0, NULL},
+    {0x0D32, "GL_MAX_CLIP_DISTANCES",                  1, 0,                  3, 0, NULL},
+    {0x84E8, "GL_MAX_RENDERBUFFER_SIZE",               1, 0,                  3, 0, "GL_ARB_framebuffer_object"},
+    {0x8CDF, "GL_MAX_COLOR_ATTACHMENTS",               1, 0,                  3, 0, "GL_ARB_framebuffer_object"},
+    {0x8D57, "GL_MAX_SAMPLES",                         1, 0,                  3, 0, "GL_ARB_framebuffer_object"},
+    {0x88FF, "GL_MAX_ARRAY_TEXTURE_LAYERS",            1, 0,                  3, 0, "GL_EXT_texture_array"},
+    {0x8C2B, "GL_MAX_TEXTURE_BUFFER_SIZE",             1, 0,                  3, 1, "GL_ARB_texture_buffer_object"},
+    {0x84F8, "GL_MAX_RECTANGLE_TEXTURE_SIZE",          1, 0,                  3, 1, "GL_ARB_texture_rectangle"},
+    {0x8A30, "GL_MAX_UNIFORM_BLOCK_SIZE",              1, 0,                  3, 1, "GL_ARB_uniform_buffer_object"},
+    {0x8A2F, "GL_MAX_UNIFORM_BUFFER_BINDINGS",         1, 0,                  3, 1, "GL_ARB_uniform_buffer_object"},
+    {0x8A2B, "GL_MAX_VERTEX_UNIFORM_BLOCKS",           1, 0,                  3, 1, "GL_ARB_uniform_buffer_object"},
+    {0x8A2D, "GL_MAX_FRAGMENT_UNIFORM_BLOCKS",         1, 0,                  3, 1, "GL_ARB_uniform_buffer_object"},
+    {0x8A2E, "GL_MAX_COMBINED_UNIFORM_BLOCKS",         1, 0,                  3, 1, "GL_ARB_uniform_buffer_object"},
+    {0x8DE0, "GL_MAX_GEOMETRY_OUTPUT_VERTICES",        1, 0,                  3, 2, "GL_ARB_geometry_shader4"},
+    {0x8DDF, "GL_MAX_GEOMETRY_UNIFORM_COMPONENTS",     1, 0,                  3, 2, "GL_ARB_geometry_shader4"},
+    {0x910E, "GL_MAX_COLOR_TEXTURE_SAMPLES",           1, 0,                  3, 2, "GL_ARB_texture_multisample"},
+    {0x910F, "GL_MAX_DEPTH_TEXTURE_SAMPLES",           1, 0,                  3, 2, "GL_ARB_texture_multisample"},
+    {0x9110, "GL_MAX_INTEGER_SAMPLES",                 1, 0,                  3, 2, "GL_ARB_texture_multisample"},
+    {0x8E59, "GL_MAX_SAMPLE_MASK_WORDS",               1, 0,                  3, 2, "GL_ARB_texture_multisample"},
+    {0x9111, "GL_MAX_SERVER_WAIT_TIMEOUT",             1, OGLI_LIMIT_INT64,   3, 2, "GL_ARB_sync"},
+    {0x88FC, "GL_MAX_DUAL_SOURCE_DRAW_BUFFERS",        1, 0,                  3, 3, "GL_ARB_blend_func_extended"},
+    {0x8E7D, "GL_MAX_PATCH_VERTICES",                  1, 0,                  4, 0, "GL_ARB_tessellation_shader"},
+    {0x8E7E, "GL_MAX_TESS_GEN_LEVEL",                  1, 0,                  4, 0, "GL_ARB_tessellation_shader"},
+    {0x825B, "GL_MAX_VIEWPORTS",                       1, 0,                  4, 1, "GL_ARB_viewport_array"},
+    {0x92DC, "GL_MAX_ATOMIC_COUNTER_BUFFER_BINDINGS",  1, 0,                  4, 2, "GL_ARB_shader_atomic_counters"},
+    {0x8F38, "GL_MAX_IMAGE_UNITS",                     1, 0,                  4, 2, "GL_ARB_shader_image_load_store"},
+    {0x91BE, "GL_MAX_COMPUTE_WORK_GROUP_COUNT",        3, OGLI_LIMIT_INDEXED, 4, 3, "GL_ARB_compute_shader"},
+    {0x91BF, "GL_MAX_COMPUTE_WORK_GROUP_SIZE",         3, OGLI_LIMIT_INDEXED, 4, 3, "GL_ARB_compute_shader"},
+    {0x90EB, "GL_MAX_COMPUTE_WORK_GROUP_INVOCATIONS",  1, 0,                  4, 3, "GL_ARB_compute_shader"},
+    {0x8262, "GL_MAX_COMPUTE_SHARED_MEMORY_SIZE",      1, 0,                  4, 3, "GL_ARB_compute_shader"},
+    {0x91BB, "GL_MAX_COMPUTE_UNIFORM_BLOCKS",          1, 0,                  4, 3, "GL_ARB_compute_shader"},
+    {0x90DE, "GL_MAX_SHADER_STORAGE_BLOCK_SIZE",       1, OGLI_LIMIT_INT64,   4, 3, "GL_ARB_shader_storage_buffer_object"},
+    {0x90DD, "GL_MAX_SHADER_STORAGE_BUFFER_BINDINGS",  1, 0,                  4, 3, "GL_ARB_shader_storage_buffer_object"},
+    {0x8D6B, "GL_MAX_ELEMENT_INDEX",                   1, OGLI_LIMIT_INT64,   4, 3, "GL_ARB_ES3_compatibility"},
+    {0x9315, "GL_MAX_FRAMEBUFFER_WIDTH",               1, 0,                  4, 3, "GL_ARB_framebuffer_no_attachments"},
+    {0x9316, "GL_MAX_FRAMEBUFFER_HEIGHT",              1, 0,                  4, 3, "GL_ARB_framebuffer_no_attachments"},
+    {0x9318, "GL_MAX_FRAMEBUFFER_SAMPLES",             1, 0,                  4, 3, "GL_ARB_framebuffer_no_attachments"},
+    {0x826E, "GL_MAX_UNIFORM_LOCATIONS",               1, 0,                  4, 3, "GL_ARB_explicit_uniform_location"},
+    {0x82DA, "GL_MAX_VERTEX_ATTRIB_BINDINGS",          1, 0,                  4, 3, "GL_ARB_vertex_attrib_binding"},
+    {0x82E8, "GL_MAX_LABEL_LENGTH",                    1, 0,                  4, 3, "GL_KHR_debug"},
+    {0x82F9, "GL_MAX_CULL_DISTANCES",                  1, 0,                  4, 5, "GL_ARB_cull_distance"},
+    {0x84FF, "GL_MAX_TEXTURE_MAX_ANISOTROPY",          1, 0,                  4, 6, "GL_EXT_texture_filter_anisotropic"}
+};
+
+#define OGLI_TOTAL_LIMITS   (sizeof(ogliLimits) / sizeof(ogliLimits[0]))
+
+static GLboolean ogliVersionAtLeast(const OGLI_CONTEXT * ctx, GLint major, GLint minor)
+{
+    return ctx->iblock.versionGL.major > major ||
+          (ctx->iblock.versionGL.major == major && ctx->iblock.versionGL.minor >= minor);
+}
+
+/* evaluates the limits table in a single pass */
+static void ogliQueryLimits(OGLI_CONTEXT * ctx)
+{
+    OGLI_GETINTEGERI_PROC   getIntegeri;
+    OGLI_GETINTEGER64_PROC  getInteger64 = NULL;
+    const OGLI_LIMIT_DESC   * desc;
+    OGLI_LIMIT  * limit;
+    GLint       values[OGLI_MAX_LIMIT_VALUES];
+    GLuint      idx, value;
+
+#if defined(__APPLE__) || defined(OGLI_USE_GLEW)
+    getIntegeri = (OGLI_GETINTEGERI_PROC) glGetIntegeri_v;
+    if (ogliVersionAtLeast(ctx, 3, 2) || ogliIndexFind(&ctx->extIndex, "GL_ARB_sync"))
+        getInteger64 = (OGLI_GETINTEGER64_PROC) glGetInteger64v;
+#else
+    getIntegeri = (OGLI_GETINTEGERI_PROC) ogliGetProcAddress(ctx, "glGetIntegeri_v");
+    if (ogliVersionAtLeast(ctx, 3, 2) || ogliIndexFind(&ctx->extIndex, "GL_ARB_sync"))
+        getInteger64 = (OGLI_GETINTEGER64_PROC) ogliGetProcAddress(ctx, "glGetInteger64v");
+#endif
+
+    /* drain errors raised before, the table gating keeps the pass itself error free */
+    while (glGetError() != GL_NO_ERROR);
+
+    memset(ctx->iblock.limits, 0, sizeof(ctx->iblock.limits));
+    ctx->iblock.totalLimits = 0;
+    for (idx = 0; idx < OGLI_TOTAL_LIMITS; idx++)
+    {
+        desc = &ogliLimits[idx];
+        limit = &ctx->iblock.limits[idx];
+
+        if ((desc->flags & OGLI_LIMIT_LEGACY) && (ctx->profile == OGLI_CORE || ctx->profile == OGLI_FORWARD))
+            continue;
+        if (!ogliVersionAtLeast(ctx, desc->major, desc->minor) &&
+            !(desc->extension && ogliIndexFind(&ctx->extIndex, desc->extension)))
+            continue;
+
+        if (desc->flags & OGLI_LIMIT_INDEXED)
+        {
+            if (!getIntegeri)
+                continue;
+            for (value = 0; value < desc->count; value++)
+            {
+                getIntegeri(desc->pname, value, values);
+                limit->values[value] = values[0];
+            }
+        }
+        else if ((desc->flags & OGLI_LIMIT_INT64) && getInteger64)
+            getInteger64(desc->pname, limit->values);
+        else
+        {
+            glGetIntegerv(desc->pname, values);
+            for (value = 0; value < desc->count; value++)
+                limit->values[value] = values[value];
+        }
+
+        limit->count = desc->count;
+        ctx->iblock.totalLimits++;
+    }
+
+    if (glGetError() != GL_NO_ERROR)
+        ogliLog("ogliQuery: Some implementation limits were rejected by the driver");
+}
+
+GLuint ogliLimitCount()
+{
+    return OGLI_TOTAL_LIMITS;
+}
+
+const char * ogliLimitName(GLuint index)
+{
+    return index < OGLI_TOTAL_LIMITS ? ogliLimits[index].name : NULL;
+}
+
+const OGLI_LIMIT * ogliGetLimit(const OGLI_CONTEXT * ctx, const char * name)
+{
+    GLuint idx;
+
+    if (!ctx || !name)
+    {
+        ogliLog("ogliGetLimit: Invalid parameters");
+        return NULL;
+    }
+
+    for (idx = 0; idx < OGLI_TOTAL_LIMITS; idx++)
+    {
+        if (strcmp(ogliLimits[idx].name, name) == 0)
+            return ctx->iblock.limits[idx].count ? &ctx->iblock.limits[idx] : NULL;
+    }
+    return NULL;
+}
+
+/*
+** Internal formats table, walked against the targets table. Without internal format queries,
+** a pair is taken as supported when the context version or the listed extension requires it,
+** with the upload format and type of the table and the renderability the specification requires.
+*/
+#define OGLI_FORMAT_DESC_COLOR      0x01    /* required color-renderable */
+#define OGLI_FORMAT_DESC_DEPTH      0x02    /* required depth or depth-stencil renderable */
+#define OGLI_FORMAT_DESC_INTEGER    0x04    /* integer format, fewer samples */
+#define OGLI_FORMAT_DESC_COMPRESSED 0x08    /* texture only */
+#define OGLI_FORMAT_EXT_ONLY        0xFF    /* never became core */
+
+typedef struct format_desc
+{
+    GLenum      internal;
+    const char  * name;
+    GLenum      format;     /* upload format and type assumed without GL_ARB_internalformat_query2 */
+    GLenum      type;
+    GLubyte     flags;
+    GLubyte     major;      /* OpenGL version the format became core in */
+    GLubyte     minor;
+    const char  * extension;/* extension that provides the format on older versions */
+} OGLI_FORMAT_DESC;
+
+static const OGLI_FORMAT_DESC ogliFormats[] =
+{
+    {0x8229, "GL_R8",                           0x1903, 0x1401, OGLI_FORMAT_DESC_COLOR,   3, 0, "GL_ARB_texture_rg"},
+    {0x822B, "GL_RG8",                          0x8227, 0x1401, OGLI_FORMAT_DESC_COLOR,   3, 0, "GL_ARB_texture_rg"},
+    {0x8051, "GL_RGB8",                         0x1907, 0x1401, 0,                        1, 1, NULL},
+    {0x8058, "GL_RGBA8",                        0x1908, 0x1401, OGLI_FORMAT_DESC_COLOR,   1, 1, NULL},
+    {0x8C43, "GL_SRGB8_ALPHA8",                 0x1908, 0x1401, OGLI_FORMAT_DESC_COLOR,   2, 1, "GL_EXT_texture_sRGB"},
+    {0x8059, "GL_RGB10_A2",                     0x1908, 0x8368, OGLI_FORMAT_DESC_COLOR,   1, 1, NULL},
+    {0x805B, "GL_RGBA16",                       0x1908, 0x1403, OGLI_FORMAT_DESC_COLOR,   1, 1, NULL},
+    {0x822D, "GL_R16F",                         0x1903, 0x140B, OGLI_FORMAT_DESC_COLOR,   3, 0, "GL_ARB_texture_rg"},
+    {0x822F, "GL_RG16F",                        0x8227, 0x140B, OGLI_FORMAT_DESC_COLOR,   3, 0, "GL_ARB_texture_rg"},
+    {0x881A, "GL_RGBA16F",                      0x1908, 0x140B, OGLI_FORMAT_DESC_COLOR,   3, 0, "GL_ARB_texture_float"},
+    {0x822E, "GL_R32F",                         0x1903, 0x1406, OGLI_FORMAT_DESC_COLOR,   3, 0, "GL_ARB_texture_rg"},
+    {0x8814, "GL_RGBA32F",                      0x1908, 0x1406, OGLI_FORMAT_DESC_COLOR,   3, 0, "GL_ARB_texture_float"},
+    {0x8C3A, "GL_R11F_G11F_B10F",               0x1907, 0x8C3B, OGLI_FORMAT_DESC_COLOR,   3, 0, "GL_EXT_packed_float"},
+    {0x8C3D, "GL_RGB9_E5",                      0x1907, 0x8C3E, 0,                        3, 0, "GL_EXT_texture_shared_exponent"},
+    {0x8D7C, "GL_RGBA8UI",                      0x8D99, 0x1401, OGLI_FORMAT_DESC_COLOR | OGLI_FORMAT_DESC_INTEGER, 3, 0, "GL_EXT_texture_integer"},
+    {0x8236, "GL_R32UI",                        0x8D94, 0x1405, OGLI_FORMAT_DESC_COLOR | OGLI_FORMAT_DESC_INTEGER, 3, 0, "GL_ARB_texture_rg"},
+    {0x81A5, "GL_DEPTH_COMPONENT16",            0x1902, 0x1403, OGLI_FORMAT_DESC_DEPTH,   1, 4, "GL_ARB_depth_texture"},
+    {0x81A6, "GL_DEPTH_COMPONENT24",            0x1902, 0x1405, OGLI_FORMAT_DESC_DEPTH,   1, 4, "GL_ARB_depth_texture"},
+    {0x8CAC, "GL_DEPTH_COMPONENT32F",           0x1902, 0x1406, OGLI_FORMAT_DESC_DEPTH,   3, 0, "GL_ARB_depth_buffer_float"},
+    {0x88F0, "GL_DEPTH24_STENCIL8",             0x84F9, 0x84FA, OGLI_FORMAT_DESC_DEPTH,   3, 0, "GL_EXT_packed_depth_stencil"},
+    {0x8CAD, "GL_DEPTH32F_STENCIL8",            0x84F9, 0x8DAD, OGLI_FORMAT_DESC_DEPTH,   3, 0, "GL_ARB_depth_buffer_float"},
+    {0x8DBB, "GL_COMPRESSED_RED_RGTC1",         0x1903, 0x1401, OGLI_FORMAT_DESC_COMPRESSED, 3, 0, "GL_ARB_texture_compression_rgtc"},
+    {0x83F3, "GL_COMPRESSED_RGBA_S3TC_DXT5_EXT",0x1908, 0x1401, OGLI_FORMAT_DESC_COMPRESSED, OGLI_FORMAT_EXT_ONLY, 0, "GL_EXT_texture_compression_s3tc"},
+    {0x8E8C, "GL_COMPRESSED_RGBA_BPTC_UNORM",   0x1908, 0x1401, OGLI_FORMAT_DESC_COMPRESSED, 4, 2, "GL_ARB_texture_compression_bptc"},
+    {0x9274, "GL_COMPRESSED_RGB8_ETC2",         0x1907, 0x1401, OGLI_FORMAT_DESC_COMPRESSED, 4, 3, "GL_ARB_ES3_compatibility"},
+    {0x93B0, "GL_COMPRESSED_RGBA_ASTC_4x4_KHR", 0x1908, 0x1401, OGLI_FORMAT_DESC_COMPRESSED, OGLI_FORMAT_EXT_ONLY, 0, "GL_KHR_texture_compression_astc_ldr"}
+};
+
+typedef struct format_target
+{
+    GLenum      target;
+    const char  * name;
+    GLboolean   multisample;
+    GLubyte     major;
+    GLubyte     minor;
+    const char  * extension;
+} OGLI_FORMAT_TARGET;
+
+static const OGLI_FORMAT_TARGET ogliFormatTargets[] =
+{
+    {0x0DE1, "GL_TEXTURE_2D",               GL_FALSE, 1, 0, NULL},
+    {0x9100, "GL_TEXTURE_2D_MULTISAMPLE",   GL_TRUE,  3, 2, "GL_ARB_texture_multisample"},
+    {0x8D41, "GL_RENDERBUFFER",             GL_TRUE,  3, 0, "GL_ARB_framebuffer_object"}
+};
+
+#define OGLI_TOTAL_FORMAT_DESCS     (sizeof(ogliFormats) / sizeof(ogliFormats[0]))
+#define OGLI_TOTAL_FORMAT_TARGETS   (sizeof(ogliFormatTargets) / sizeof(ogliFormatTargets[0]))
+#define OGLI_TOTAL_FORMATS          (OGLI_TOTAL_FORMAT_DESCS * OGLI_TOTAL_FORMAT_TARGETS)
+
+/* pixel formats and types the table and the drivers answer with */
+static const struct { GLenum value; const char * name; } ogliPixelNames[] =
+{
+    {0x0000, "GL_NONE"},            {0x1401, "GL_UNSIGNED_BYTE"},   {0x1403, "GL_UNSIGNED_SHORT"},
+    {0x1405, "GL_UNSIGNED_INT"},    {0x1406, "GL_FLOAT"},           {0x140B, "GL_HALF_FLOAT"},
+    {0x1400, "GL_BYTE"},            {0x1402, "GL_SHORT"},           {0x1404, "GL_INT"},
+    {0x1902, "GL_DEPTH_COMPONENT"}, {0x1903, "GL_RED"},             {0x1907, "GL_RGB"},
+    {0x1908, "GL_RGBA"},            {0x80E0, "GL_BGR"},             {0x80E1, "GL_BGRA"},
+    {0x8227, "GL_RG"},              {0x8228, "GL_RG_INTEGER"},      {0x8D94, "GL_RED_INTEGER"},
+    {0x8D98, "GL_RGB_INTEGER"},     {0x8D99, "GL_RGBA_INTEGER"},    {0x84F9, "GL_DEPTH_STENCIL"},
+    {0x1901, "GL_STENCIL_INDEX"},   {0x84FA, "GL_UNSIGNED_INT_24_8"},
+    {0x8367, "GL_UNSIGNED_INT_8_8_8_8_REV"},        {0x8368, "GL_UNSIGNED_INT_2_10_10_10_REV"},
+    {0x8C3B, "GL_UNSIGNED_INT_10F_11F_11F_REV"},    {0x8C3E, "GL_UNSIGNED_INT_5_9_9_9_REV"},
+    {0x8DAD, "GL_FLOAT_32_UNSIGNED_INT_24_8_REV"},  {0x8363, "GL_UNSIGNED_SHORT_5_6_5"}
+};
+
+#define OGLI_INTERNALFORMAT_SUPPORTED   0x826F
+#define OGLI_COLOR_RENDERABLE           0x8286
+#define OGLI_DEPTH_RENDERABLE           0x8287
+#define OGLI_TEXTURE_IMAGE_FORMAT       0x828F
+#define OGLI_TEXTURE_IMAGE_TYPE         0x8290
+#define OGLI_NUM_SAMPLE_COUNTS          0x9380
+#define OGLI_SAMPLES                    0x80A9
+#define OGLI_MAX_SAMPLES                0x8D57
+#define OGLI_MAX_INTEGER_SAMPLES        0x9110
+
+static GLboolean ogliFormatAvailable(const OGLI_CONTEXT * ctx, GLubyte major, GLubyte minor, const char * extension)
+{
+    return (major != OGLI_FORMAT_EXT_ONLY && ogliVersionAtLeast(ctx, major, minor)) ||
+           (extension && ogliIndexFind(&ctx->extIndex, extension));
+}
+
+/* highest sample count, the driver lists them in descending order */
+static GLint ogliFormatSamples(OGLI_GETINTERNALFORMAT_PROC getInternalformat, GLenum target, GLenum internal)
+{
+    GLint counts = 0, samples = 0;
+
+    getInternalformat(target, internal, OGLI_NUM_SAMPLE_COUNTS, 1, &counts);
+    if (counts > 0)
+        getInternalformat(target, internal, OGLI_SAMPLES, 1, &samples);
+    return samples;
+}
+
+/* one pass over the table, GL_ARB_internalformat_query2 answers every question of a pair */
+static void ogliQueryFormat2(OGLI_GETINTERNALFORMAT_PROC getInternalformat, GLenum target, GLenum internal,
+                             GLboolean multisample, OGLI_FORMAT * format)
+{
+    GLint value = 0;
+
+    getInternalformat(target, internal, OGLI_INTERNALFORMAT_SUPPORTED, 1, &value);
+    if (!value)
+        return;
+
+    format->flags = OGLI_FORMAT_SUPPORTED;
+    value = 0;
+    getInternalformat(target, internal, OGLI_COLOR_RENDERABLE, 1, &value);
+    if (value)
+        format->flags |= OGLI_FORMAT_COLOR_RENDERABLE;
+    value = 0;
+    getInternalformat(target, internal, OGLI_DEPTH_RENDERABLE, 1, &value);
+    if (value)
+        format->flags |= OGLI_FORMAT_DEPTH_RENDERABLE;
+
+    value = 0;
+    getInternalformat(target, internal, OGLI_TEXTURE_IMAGE_FORMAT, 1, &value);
+    format->format = (GLenum) value;
+    value = 0;
+    getInternalformat(target, internal, OGLI_TEXTURE_IMAGE_TYPE, 1, &value);
+    format->type = (GLenum) value;
+
+    if (multisample)
+        format->maxSamples = ogliFormatSamples(getInternalformat, target, internal);
+}
+
+/* the fallback trusts the specification, GL_ARB_internalformat_query still gives real sample counts */
+static void ogliQueryFormatSpec(OGLI_GETINTERNALFORMAT_PROC getInternalformat, const OGLI_FORMAT_DESC * desc,
+                                const OGLI_FORMAT_TARGET * target, GLint maxSamples, GLint maxIntegerSamples,
+                                OGLI_FORMAT * format)
+{
+    /* renderbuffers and multisample textures need a renderable format */
+    if (target->multisample && !(desc->flags & (OGLI_FORMAT_DESC_COLOR | OGLI_FORMAT_DESC_DEPTH)))
+        return;
+
+    format->flags = OGLI_FORMAT_SUPPORTED;
+    if (desc->flags & OGLI_FORMAT_DESC_COLOR)
+        format->flags |= OGLI_FORMAT_COLOR_RENDERABLE;
+    if (desc->flags & OGLI_FORMAT_DESC_DEPTH)
+        format->flags |= OGLI_FORMAT_DEPTH_RENDERABLE;
+    if (target->target != 0x8D41)
+    {
+        format->format = desc->format;
+        format->type = desc->type;
+    }
+
+    if (!target->multisample)
+        return;
+    if (getInternalformat)
+        format->maxSamples = ogliFormatSamples(getInternalformat, target->target, desc->internal);
+    else
+        format->maxSamples = (desc->flags & OGLI_FORMAT_DESC_INTEGER) ? maxIntegerSamples : maxSamples;
+}
+
+GLboolean ogliQueryFormats(OGLI_CONTEXT * ctx)
+{
+    OGLI_GETINTERNALFORMAT_PROC getInternalformat;
+    const OGLI_FORMAT_DESC      * desc;
+    const OGLI_FORMAT_TARGET    * target;
+    OGLI_FORMAT * format;
+    GLint       maxSamples = 0, maxIntegerSamples = 0;
+    GLuint      idx, jdx;
+
+    if (!ctx)
+    {
+        ogliLog("ogliQueryFormats: Invalid OGLI context");
+        return GL_FALSE;
+    }
+
+    if (!ctx->active)
+    {
+        ogliLog("ogliQueryFormats: OGLI is not ready");
+        return GL_FALSE;
+    }
+
+    /* the formats are gated by the version and the extensions */
+    if (!ogliQueryEx(ctx, OGLI_Q_EXTENSIONS))
+        return GL_FALSE;
+
+#if defined(__APPLE__)
+    getInternalformat = NULL;   /* OpenGL 4.1 at most */
+#elif defined(OGLI_USE_GLEW)
+    getInternalformat = (OGLI_GETINTERNALFORMAT_PROC) glGetInternalformativ;
+#else
+    getInternalformat = (OGLI_GETINTERNALFORMAT_PROC) ogliGetProcAddress(ctx, "glGetInternalformativ");
+#endif
+
+    if (getInternalformat && (ogliVersionAtLeast(ctx, 4, 3) || ogliIndexFind(&ctx->extIndex, "GL_ARB_internalformat_query2")))
+        ctx->iblock.formatSource = OGLI_FORMATS_QUERY2;
+    else if (getInternalformat && (ogliVersionAtLeast(ctx, 4, 2) || ogliIndexFind(&ctx->extIndex, "GL_ARB_internalformat_query")))
+        ctx->iblock.formatSource = OGLI_FORMATS_QUERY;
+    else
+    {
+        ctx->iblock.formatSource = OGLI_FORMATS_SPEC;
+        getInternalformat = NULL;
+    }
+
+    while (glGetError() != GL_NO_ERROR);
+    if (ctx->iblock.formatSource == OGLI_FORMATS_SPEC && ogliFormatAvailable(ctx, 3, 0, "GL_ARB_framebuffer_object"))
+        glGetIntegerv(OGLI_MAX_SAMPLES, &maxSamples);
+    if (ctx->iblock.formatSource == OGLI_FORMATS_SPEC && ogliFormatAvailable(ctx, 3, 2, "GL_ARB_texture_multisample"))
+        glGetIntegerv(OGLI_MAX_INTEGER_SAMPLES, &maxIntegerSamples);
+
+    memset(ctx->iblock.formats, 0, sizeof(ctx->iblock.formats));
+    ctx->iblock.totalFormats = 0;
+    for (idx = 0; idx < OGLI_TOTAL_FORMAT_DESCS; idx++)
+    {
+        desc = &ogliFormats[idx];
+        for (jdx = 0; jdx < OGLI_TOTAL_FORMAT_TARGETS; jdx++)
+        {
+            target = &ogliFormatTargets[jdx];
+            format = &ctx->iblock.formats[idx * OGLI_TOTAL_FORMAT_TARGETS + jdx];
+
+            /* the driver is not even asked about pairs the context cannot have */
+            if (!ogliFormatAvailable(ctx, desc->major, desc->minor, desc->extension) ||
+                !ogliFormatAvailable(ctx, target->major, target->minor, target->extension))
+                continue;
+
+            if (ctx->iblock.formatSource == OGLI_FORMATS_QUERY2)
+                ogliQueryFormat2(getInternalformat, target->target, desc->internal, target->multisample, format);
+            else
+                ogliQueryFormatSpec(getInternalformat, desc, target, maxSamples, maxIntegerSamples, format);
+            if (format->flags)
+                ctx->iblock.totalFormats++;
+        }
+    }
+
+    if (glGetError() != GL_NO_ERROR)
+        ogliLog("ogliQueryFormats: Some internal format queries were rejected by the driver");
+    return GL_TRUE;
+}
+
+GLuint ogliFormatCount()
+{
+    return OGLI_TOTAL_FORMATS;
+}
+
+const char * ogliFormatName(GLuint index)
+{
+    return index < OGLI_TOTAL_FORMATS ? ogliFormats[index / OGLI_TOTAL_FORMAT_TARGETS].name : NULL;
+}
+
+const char * ogliFormatTarget(GLuint index)
+{
+    return index < OGLI_TOTAL_FORMATS ? ogliFormatTargets[index % OGLI_TOTAL_FORMAT_TARGETS].name : NULL;
+}
+
+const char * ogliFormatSourceName(OGLI_FORMAT_SOURCE source)
+{
+    static const char * names[] = {"none", "spec", "query", "query2"};
+
+    return (unsigned) source <= OGLI_FORMATS_QUERY2 ? names[source] : "unknown";
+}
+
+const char * ogliPixelName(GLenum value)
+{
+    GLuint idx;
+
+    for (idx = 0; idx < sizeof(ogliPixelNames) / sizeof(ogliPixelNames[0]); idx++)
+        if (ogliPixelNames[idx].value == value)
+            return ogliPixelNames[idx].name;
+    return NULL;
+}
+
+const OGLI_FORMAT * ogliGetFormat(const OGLI_CONTEXT * ctx, const char * format, const char * target)
+{
+    GLuint idx;
+
+    if (!ctx || !format || !target)
+    {
+        ogliLog("ogliGetFormat: Invalid parameters");
+        return NULL;
+    }
+
+    for (idx = 0; idx < OGLI_TOTAL_FORMATS; idx++)
+    {
+        if (strcmp(ogliFormatName(idx), format) == 0 && strcmp(ogliFormatTarget(idx), target) == 0)
+            return ctx->iblock.formats[idx].flags ? &ctx->iblock.formats[idx] : NULL;
+    }
+    return NULL;
+}
+
+/*
+** Timers. Timestamps are taken by glQueryCounter() so that measurements may nest, and results
+** are only read once GL_QUERY_RESULT_AVAILABLE says so. GL_TIME_ELAPSED stands in for drivers
+** with no timestamp counter bits, its measurements cannot nest.
+*/
+#define OGLI_TIME_ELAPSED               0x88BF
+#define OGLI_TIMESTAMP                  0x8E28
+#define OGLI_QUERY_COUNTER_BITS         0x8864
+#define OGLI_QUERY_RESULT               0x8866
+#define OGLI_QUERY_RESULT_AVAILABLE     0x8867
+#define OGLI_TIMER_SAMPLES              (16)    /* clock pairs read for the offset */
+#define OGLI_TIMER_STEPS                (1000)  /* clock reads searching the resolution */
+
+static GLboolean ogliTimerLoad(OGLI_CONTEXT * ctx, OGLI_TIMER * timer)
+{
+#if defined(__APPLE__) || defined(OGLI_USE_GLEW)
+    timer->genQueries           = (OGLI_GENQUERIES_PROC) glGenQueries;
+    timer->deleteQueries        = (OGLI_DELETEQUERIES_PROC) glDeleteQueries;
+    timer->beginQuery           = (OGLI_BEGINQUERY_PROC) glBeginQuery;
+    timer->endQuery             = (OGLI_ENDQUERY_PROC) glEndQuery;
+    timer->queryCounter         = (OGLI_QUERYCOUNTER_PROC) glQueryCounter;
+    timer->getQueryiv           = (OGLI_GETQUERYIV_PROC) glGetQueryiv;
+    timer->getQueryObjectiv     = (OGLI_GETQUERYOBJECTIV_PROC) glGetQueryObjectiv;
+    timer->getQueryObjectui64v  = (OGLI_GETQUERYOBJECTUI64_PROC) glGetQueryObjectui64v;
+    timer->getInteger64v        = (OGLI_GETINTEGER64_PROC) glGetInteger64v;
+#else
+    timer->genQueries           = (OGLI_GENQUERIES_PROC) ogliGetProcAddress(ctx, "glGenQueries");
+    timer->deleteQueries        = (OGLI_DELETEQUERIES_PROC) ogliGetProcAddress(ctx, "glDeleteQueries");
+    timer->beginQuery           = (OGLI_BEGINQUERY_PROC) ogliGetProcAddress(ctx, "glBeginQuery");
+    timer->endQuery             = (OGLI_ENDQUERY_PROC) ogliGetProcAddress(ctx, "glEndQuery");
+    timer->queryCounter         = (OGLI_QUERYCOUNTER_PROC) ogliGetProcAddress(ctx, "glQueryCounter");
+    timer->getQueryiv           = (OGLI_GETQUERYIV_PROC) ogliGetProcAddress(ctx, "glGetQueryiv");
+    timer->getQueryObjectiv     = (OGLI_GETQUERYOBJECTIV_PROC) ogliGetProcAddress(ctx, "glGetQueryObjectiv");
+    timer->getQueryObjectui64v  = (OGLI_GETQUERYOBJECTUI64_PROC) ogliGetProcAddress(ctx, "glGetQueryObjectui64v");
+    timer->getInteger64v        = (OGLI_GETINTEGER64_PROC) ogliGetProcAddress(ctx, "glGetInteger64v");
+#endif
+    return timer->genQueries && timer->deleteQueries && timer->beginQuery && timer->endQuery &&
+           timer->queryCounter && timer->getQueryiv && timer->getQueryObjectiv &&
+           timer->getQueryObjectui64v && timer->getInteger64v;
+}
+
+OGLI_TIMER * ogliTimerCreate(OGLI_CONTEXT * ctx)
+{
+    OGLI_TIMER  * timer;
+    GLint       bits = 0;
+
+    if (!ctx)
+    {
+        ogliLog("ogliTimerCreate: Invalid OGLI context");
+        return NULL;
+    }
+
+    if (!ctx->active)
+    {
+        ogliLog("ogliTimerCreate: OGLI is not ready");
+        return NULL;
+    }
+
+    if (!ogliQueryEx(ctx, OGLI_Q_EXTENSIONS))
+        return NULL;
+
+    timer = (OGLI_TIMER *) calloc(1, sizeof(OGLI_TIMER));
+    if (!timer)
+    {
+        ogliLog("ogliTimerCreate: Not enough memory");
+        return NULL;
+    }
+
+    /* the CPU fallback times submission only, the mode tells the caller */
+    timer->mode = OGLI_TIMER_CPU;
+    if ((ogliVersionAtLeast(ctx, 3, 3) || ogliIndexFind(&ctx->extIndex, "GL_ARB_timer_query")) && ogliTimerLoad(ctx, timer))
+    {
+        timer->getQueryiv(OGLI_TIMESTAMP, OGLI_QUERY_COUNTER_BITS, &bits);
+        timer->mode = bits > 0 ? OGLI_TIMER_TIMESTAMP : OGLI_TIMER_ELAPSED;
+        timer->genQueries(OGLI_TIMER_RING * 2, timer->queries);
+    }
+    return timer;
+}
+
+/* reads the clock the timer counts with, in seconds */
+static double ogliTimerClock(OGLI_TIMER * timer)
+{
+    GLint64 gpu;
+
+    if (timer->mode != OGLI_TIMER_TIMESTAMP)
+        return ogliNow();
+    timer->getInteger64v(OGLI_TIMESTAMP, &gpu);
+    return (double) gpu * 1e-9;
+}
+
+/* smallest nonzero step between consecutive clock reads, then the offset of the closest pair */
+GLboolean ogliTimerCalibrate(OGLI_TIMER * timer)
+{
+    GLint64 gpu, last = 0;
+    double  before, after, now, previous, step = 0, best = 0;
+    GLuint  idx;
+
+    if (!timer)
+    {
+        ogliLog("ogliTimerCalibrate: Invalid timer");
+        return GL_FALSE;
+    }
+
+    /* steps are only measured between two reads of the same clock */
+    previous = ogliTimerClock(timer);
+    for (idx = 0; idx < OGLI_TIMER_STEPS; idx++)
+    {
+        now = ogliTimerClock(timer);
+        if (now > previous && (step == 0 || now - previous < step))
+            step = now - previous;
+        previous = now;
+    }
+    timer->resolution = timer->mode == OGLI_TIMER_ELAPSED ? 1e-9 : step;
+
+    /* GL_TIME_ELAPSED and the CPU have no clock of their own to align */
+    timer->offset = 0;
+    if (timer->mode != OGLI_TIMER_TIMESTAMP)
+        return GL_TRUE;
+
+    for (idx = 0; idx < OGLI_TIMER_SAMPLES; idx++)
+    {
+        before = ogliNow();
+        timer->getInteger64v(OGLI_TIMESTAMP, &gpu);
+        after = ogliNow();
+        if (idx == 0 || after - before < best)
+        {
+            best = after - before;
+            last = gpu;
+            timer->offset = (before + after) / 2 - (double) last * 1e-9;
+        }
+    }
+    return GL_TRUE;
+}
+
+GLboolean ogliTimerBegin(OGLI_TIMER * timer)
+{
+    GLuint slot;
+
+    if (!timer || timer->running)
+    {
+        ogliLog("ogliTimerBegin: Invalid or running timer");
+        return GL_FALSE;
+    }
+
+    /* a full ring is back pressure, not an error */
+    if (timer->issued - timer->read >= OGLI_TIMER_RING)
+        return GL_FALSE;
+
+    slot = (timer->issued % OGLI_TIMER_RING) * 2;
+    timer->submitted[slot] = ogliNow();
+    if (timer->mode == OGLI_TIMER_TIMESTAMP)
+        timer->queryCounter(timer->queries[slot], OGLI_TIMESTAMP);
+    else if (timer->mode == OGLI_TIMER_ELAPSED)
+        timer->beginQuery(OGLI_TIME_ELAPSED, timer->queries[slot]);
+    timer->running = GL_TRUE;
+    return GL_TRUE;
+}
+
+GLboolean ogliTimerEnd(OGLI_TIMER * timer)
+{
+    GLuint slot;
+
+    if (!timer || !timer->running)
+    {
+        ogliLog("ogliTimerEnd: Timer is not running");
+        return GL_FALSE;
+    }
+
+    slot = (timer->issued % OGLI_TIMER_RING) * 2;
+    if (timer->mode == OGLI_TIMER_TIMESTAMP)
+        timer->queryCounter(timer->queries[slot + 1], OGLI_TIMESTAMP);
+    else if (timer->mode == OGLI_TIMER_ELAPSED)
+        timer->endQuery(OGLI_TIME_ELAPSED);
+    timer->submitted[slot + 1] = ogliNow();
+    timer->issued++;
+    timer->running = GL_FALSE;
+    return GL_TRUE;
+}
+
+/* oldest pending measurement, 'start' is on the ogliNow() clock */
+GLboolean ogliTimerRead(OGLI_TIMER * timer, double * start, double * elapsed)
+{
+    GLuint64    begin = 0, end = 0;
+    GLint       available = 0;
+    GLuint      slot;
+
+    if (!timer || timer->read == timer->issued)
+        return GL_FALSE;
+
+    slot = (timer->read % OGLI_TIMER_RING) * 2;
+    switch (timer->mode)
+    {
+        case OGLI_TIMER_TIMESTAMP:
+            timer->getQueryObjectiv(timer->queries[slot + 1], OGLI_QUERY_RESULT_AVAILABLE, &available);
+            if (!available)
+                return GL_FALSE;
+            timer->getQueryObjectui64v(timer->queries[slot], OGLI_QUERY_RESULT, &begin);
+            timer->getQueryObjectui64v(timer->queries[slot + 1], OGLI_QUERY_RESULT, &end);
+            if (start)      *start = (double) begin * 1e-9 + timer->offset;
+            if (elapsed)    *elapsed = (double) (end - begin) * 1e-9;
+            break;
+
+        case OGLI_TIMER_ELAPSED:
+            timer->getQueryObjectiv(timer->queries[slot], OGLI_QUERY_RESULT_AVAILABLE, &available);
+            if (!available)
+                return GL_FALSE;
+            timer->getQueryObjectui64v(timer->queries[slot], OGLI_QUERY_RESULT, &end);
+            if (start)      *start = timer->submitted[slot];
+            if (elapsed)    *elapsed = (double) end * 1e-9;
+            break;
+
+        default:
+            if (start)      *start = timer->submitted[slot];
+            if (elapsed)    *elapsed = timer->submitted[slot + 1] - timer->submitted[slot];
+    }
+    timer->read++;
+    return GL_TRUE;
+}
+
+GLboolean ogliTimerDestroy(OGLI_TIMER * timer)
+{
+    if (!timer)
+    {
+        ogliLog("ogliTimerDestroy: Invalid timer");
+        return GL_FALSE;
+    }
+
+    if (timer->mode != OGLI_TIMER_CPU)
+        timer->deleteQueries(OGLI_TIMER_RING * 2, timer->queries);
+    free(timer);
+    return GL_TRUE;
+}
+
+static const OGLI_EXT_LIST * ogliExtensionList(const OGLI_CONTEXT * ctx, OGLI_EXT_SOURCE source)
+{
+    if (!ctx)
+        return NULL;
+    return source == OGLI_EXT_GLU ? &ctx->iblock.gluExtensions : &ctx->iblock.glExtensions;
+}
+
+GLuint ogliExtensionCount(const OGLI_CONTEXT * ctx, OGLI_EXT_SOURCE source)
+{
+    const OGLI_EXT_LIST * list = ogliExtensionList(ctx, source);
+
+    return list ? list->count : 0;
+}
+
+const char * ogliExtensionAt(const OGLI_CONTEXT * ctx, OGLI_EXT_SOURCE source, GLuint index, GLuint * length)
+{
+    const OGLI_EXT_LIST * list = ogliExtensionList(ctx, source);
+
+    if (!list || index >= list->count)
+    {
+        ogliLog("ogliExtensionAt: Extension index out of range");
+        if (length)
+            *length = 0;
+        return NULL;
+    }
+
+    /* a view into the stored list, nothing is copied */
+    if (length)
+        *length = list->offsets[index + 1] - list->offsets[index] - 1;
+    return list->names + list->offsets[index];
+}
+
+GLuint ogliForEachExtension(const OGLI_CONTEXT * ctx, OGLI_EXT_SOURCE source, OGLI_EXT_CALLBACK callback, void * user)
+{
+    const OGLI_EXT_LIST * list = ogliExtensionList(ctx, source);
+    GLuint idx;
+
+    if (!list || !callback)
+    {
+        ogliLog("ogliForEachExtension: Invalid parameters");
+        return 0;
+    }
+
+    for (idx = 0; idx < list->count; idx++)
+    {
+        if (!callback(list->names + list->offsets[idx], list->offsets[idx + 1] - list->offsets[idx] - 1, user))
+            return idx + 1;
+    }
+    return idx;
+}
+
+/* strings and versions, the extension count is read without fetching the list */
+static void ogliQueryBasic(OGLI_CONTEXT * ctx)
+{
+    const char * ext;
+    char *  glsl;
+    GLint   numExts = 0;
+
+    /* reads the basic OpenGL information and store them into our information block */
+    strncpy((char *) ctx->iblock.glRenderer,  (char *) glGetString(GL_RENDERER), OGLI_MAX_INFO_LENGTH-1);
+    strncpy((char *) ctx->iblock.glVendor,    (char *) glGetString(GL_VENDOR), OGLI_MAX_INFO_LENGTH-1);
+    strncpy((char *) ctx->iblock.glVersion,   (char *) glGetString(GL_VERSION), OGLI_MAX_INFO_LENGTH-1);
+
+    /* extracts the OpenGL version number */
+    sscanf(ctx->iblock.glVersion, "%d.%d.%d", &ctx->iblock.versionGL.major, 
+                                              &ctx->iblock.versionGL.minor,
+                                              &ctx->iblock.versionGL.release);
+
+    /* GLSL only present from OpenGL 2.0+ */
+    if (ctx->iblock.versionGL.major >= 2)
+    {
+        /* double check :) */
+        glsl = (char *) glGetString(GL_SHADING_LANGUAGE_VERSION); 
+        if (!glsl)
+            strcpy((char *) ctx->iblock.glSL, "None");
+        else
+        {
+            strcpy((char *) ctx->iblock.glSL, glsl);
+            /* extracts the GLSL version number */
+            sscanf(ctx->iblock.glSL, "%d.%d", &ctx->iblock.versionGLSL.major, &ctx->iblock.versionGLSL.minor);
+        }
+    }
+    else
+        strcpy((char *) ctx->iblock.glSL, "None");
+
+    /* OpenGL 3.0 counts them, older versions only have the string to count the names of */
+    if (ctx->iblock.versionGL.major >= 3)
+        glGetIntegerv(GL_NUM_EXTENSIONS, &numExts);
+    else
+    {
+        ext = (const char *) glGetString(GL_EXTENSIONS);
+        for (; ext && *ext; ext++)
+            if (*ext != ' ' && (ext[1] == ' ' || ext[1] == '\0'))
+                numExts++;
+    }
+    ctx->iblock.totalExtensions = numExts;
+}
+
+static GLboolean ogliQueryExtensions(OGLI_CONTEXT * ctx)
+{
+    const char * ext;
+    char *  tail;
+    GLint   numExts, idx;
+    GLuint  bytes;
+
+    /* stores the extensions list for later use */ 
+    if (ctx->profile == OGLI_LEGACY ||              /* use legacy profile */
+        ctx->getStringi == NULL)                    /* or error while init core profile */
+    {
+        if (!ogliExtListParse(&ctx->iblock.glExtensions, (const char *) glGetString(GL_EXTENSIONS)))
+            return GL_FALSE;
+    }
+    else
+    {
+        /* measure all names first so that the list is allocated exactly once */
+        glGetIntegerv(GL_NUM_EXTENSIONS, &numExts);
+        for (idx = 0, bytes = 0; idx < numExts; idx++)
+        {
+            ext = (const char *) ctx->getStringi(GL_EXTENSIONS, idx);
+            bytes += ext ? (GLuint) strlen(ext) + 1 : 0;
+        }
+
+        if (!ogliExtListAlloc(&ctx->iblock.glExtensions, numExts, bytes))
+            return GL_FALSE;
+
+        for (idx = 0, tail = ctx->iblock.glExtensions.names; idx < numExts; idx++)
+        {
+            ext = (const char *) ctx->getStringi(GL_EXTENSIONS, idx);
+            if (ext)
+                tail = ogliExtListAppend(&ctx->iblock.glExtensions, tail, ext, (GLuint) strlen(ext));
+        }
+    }
+    ctx->iblock.totalExtensions = ctx->iblock.glExtensions.count;
+
+    /* index the extensions once so that lookups do not rescan the string */
+    return ogliIndexBuild(&ctx->extIndex, &ctx->iblock.glExtensions);
+}
+
+/* libGLU is not linked on Linux, only opened by the first query that needs its strings */
+#ifdef __linux__
+typedef const GLubyte * (APIENTRY * OGLI_GLUGETSTRING_PROC)(GLenum name);
+static OGLI_GLUGETSTRING_PROC ogliGluGetString = NULL;
+static pthread_once_t gluOnce = PTHREAD_ONCE_INIT;
+
+static void ogliLoadGLU(void)
+{
+    void * lib = dlopen("libGLU.so.1", RTLD_LAZY | RTLD_LOCAL);
+
+    if (lib)
+        ogliGluGetString = (OGLI_GLUGETSTRING_PROC) dlsym(lib, "gluGetString");
+}
+#endif /* __linux__ */
+
+static const char * ogliGluString(GLenum name)
+{
+#ifdef __linux__
+    pthread_once(&gluOnce, ogliLoadGLU);
+    return ogliGluGetString ? (const char *) ogliGluGetString(name) : NULL;
+#else
+    return (const char *) gluGetString(name);
+#endif /* __linux__ */
+}
+
+/* a missing libGLU is reported as "None", like a missing GLSL */
+static GLboolean ogliQueryGLU(OGLI_CONTEXT * ctx)
+{
+    const char * version = ogliGluString(GLU_VERSION);
+
+    strncpy((char *) ctx->iblock.gluVersion, version ? version : "None", OGLI_MAX_INFO_LENGTH-1);
+    return ogliExtListParse(&ctx->iblock.gluExtensions, ogliGluString(GLU_EXTENSIONS));
+}
+
+GLboolean ogliQueryEx(OGLI_CONTEXT * ctx, GLuint mask)
+{
+    if (!ctx)
+    {
+        ogliLog("ogliQueryEx: Invalid OGLI context");
+        return GL_FALSE;
+    }
+
+    if (!ctx->active)
+    {
+        ogliLog("ogliQueryEx: OGLI is not ready");
+        return GL_FALSE;
+    }
+
+    /* limits are gated by the version and the extensions, extensions by the profile version */
+    if (mask & OGLI_Q_LIMITS)
+        mask |= OGLI_Q_EXTENSIONS;
+    if (mask & OGLI_Q_EXTENSIONS)
+        mask |= OGLI_Q_BASIC;
+    mask &= ~ctx->queried;
+
+    if (mask & (OGLI_Q_BASIC | OGLI_Q_EXTENSIONS))
+    {
+        OGLI_BEGIN(ctx, OGLI_PHASE_QUERY);
+        if (mask & OGLI_Q_BASIC)
+            ogliQueryBasic(ctx);
+        if ((mask & OGLI_Q_EXTENSIONS) && !ogliQueryExtensions(ctx))
+            return GL_FALSE;
+        OGLI_END(ctx, OGLI_PHASE_QUERY);
+        ctx->queried |= mask & (OGLI_Q_BASIC | OGLI_Q_EXTENSIONS);
+    }
+
+    if (mask & OGLI_Q_LIMITS)
+    {
+        OGLI_BEGIN(ctx, OGLI_PHASE_LIMITS);
+        ogliQueryLimits(ctx);
+        OGLI_END(ctx, OGLI_PHASE_LIMITS);
+        ctx->queried |= OGLI_Q_LIMITS;
+    }
+
+    /* OpenGL Utility Library */
+    if (mask & OGLI_Q_GLU)
+    {
+        OGLI_BEGIN(ctx, OGLI_PHASE_GLU);
+        if (!ogliQueryGLU(ctx))
+            return GL_FALSE;
+        OGLI_END(ctx, OGLI_PHASE_GLU);
+        ctx->queried |= OGLI_Q_GLU;
+    }
+
+    return GL_TRUE; 
+}
+
+GLboolean ogliQuery(OGLI_CONTEXT * ctx)
+{
+    return ogliQueryEx(ctx, OGLI_Q_ALL);
+}
+
+/* the parts of the mask, fetched first if the context is still alive */
+const GL_INFO_BLOCK * ogliGetInfo(OGLI_CONTEXT * ctx, GLuint mask)
+{
+    if (!ctx)
+    {
+        ogliLog("ogliGetInfo: Invalid OGLI context");
+        return NULL;
+    }
+
+    if ((ctx->queried & mask) != mask)
+    {
+        if (!ctx->active)
+        {
+            ogliLog("ogliGetInfo: Information was not queried while the context was active");
+            return NULL;
+        }
+        if (!ogliQueryEx(ctx, mask))
+            return NULL;
+    }
+    return &ctx->iblock;
+}
+
+/*------------------------------------------------------------------------------------------------*/
+/*                                    CAPABILITY CACHE                                            */
+/*------------------------------------------------------------------------------------------------*/
+
+/*
+** NOTES
+** -----
+** The cache stores the information block of a profile in a flat binary file that can be mapped
+** as is. The file is named after a hash of the cache key, the key itself is stored inside the 
+** file and compared on load. It is made of the profile, the backend, the display, the resolved 
+** OpenGL libraries with their sizes and modification times, the installed vendor libraries 
+** (GLVND ICDs and Mesa DRI drivers) and the environment variables that redirect the driver.
+**
+** File layout: header | key | GL_INFO_BLOCK | GL extension list | GLU extension list
+*/
+
+#ifndef _WIN32
+
+#define OGLI_CACHE_MAGIC        "OGLICAP"
+#define OGLI_CACHE_FORMAT       1
+#define OGLI_MAX_KEY_LENGTH     4096
+
+typedef struct cache_header
+{
+    char    magic[8];
+    GLuint  format;             /* file format version */
+    GLuint  blockSize;          /* sizeof(GL_INFO_BLOCK) when written, guards layout changes */
+    GLuint  keySize;            /* key length, including the terminator */
+    GLuint  glCount, glSize;    /* GL extension list */
+    GLuint  gluCount, gluSize;  /* GLU extension list */
+    GLuint  totalSize;          /* size of the whole file */
+} OGLI_CACHE_HEADER;
+
+/* appends "name=size:mtime;" for a file, missing files are recorded as well */
+static size_t ogliCacheKeyFile(char * key, size_t used, const char * path)
+{
+    struct stat st;
+
+    if (stat(path, &st) != 0)
+        return used + snprintf(key + used, OGLI_MAX_KEY_LENGTH - used, "%s=-;", path);
+    return used + snprintf(key + used, OGLI_MAX_KEY_LENGTH - used, "%s=%lld:%lld;", path, 
+                           (long long) st.st_size, (long long) st.st_mtime);
+}
+
+/* appends the library that provides 'symbol' and optionally the vendor libraries next to it */
+static size_t ogliCacheKeyLibrary(char * key, size_t used, const void * symbol, GLboolean vendorLibs)
+{
+    static const char * vendors[] = {"libGLX_mesa.so.0", "libGLX_nvidia.so.0", "libGLX_indirect.so.0",
+                                     "libEGL_mesa.so.0", "libEGL_nvidia.so.0", "dri", NULL};
+    char    path[1024], * slash;
+    Dl_info info;
+    GLuint  idx;
+
+    if (!dladdr(symbol, &info) || !info.dli_fname)
+        return used;
+    used = ogliCacheKeyFile(key, used, info.dli_fname);
+    if (!vendorLibs)
+        return used;
+
+    strncpy(path, info.dli_fname, sizeof(path) - 64);
+    path[sizeof(path) - 64] = '\0';
+    slash = strrchr(path, '/');
+    if (!slash)
+        return used;
+
+    for (idx = 0; vendors[idx] && used < OGLI_MAX_KEY_LENGTH; idx++)
+    {
+        strcpy(slash + 1, vendors[idx]);
+        used = ogliCacheKeyFile(key, used, path);
+    }
+    return used;
+}
+
+static GLboolean ogliCacheKey(const OGLI_CONTEXT * ctx, char * key)
+{
+    static const char * vars[] = {"DISPLAY", "LIBGL_ALWAYS_SOFTWARE", "LIBGL_ALWAYS_INDIRECT", "GALLIUM_DRIVER",
+                                  "MESA_LOADER_DRIVER_OVERRIDE", "MESA_GL_VERSION_OVERRIDE", "MESA_EXTENSION_OVERRIDE",
+                                  "DRI_PRIME", "__GLX_VENDOR_LIBRARY_NAME", "__EGL_VENDOR_LIBRARY_FILENAMES", 
+                                  "__NV_PRIME_RENDER_OFFLOAD", NULL};
+    const char  * value;
+    size_t      used;
+    GLuint      idx;
+
+    used = snprintf(key, OGLI_MAX_KEY_LENGTH, "%s %d.%d profile=%d backend=%d;", OGLI_PLATFORM, 
+                    OGLI_MAJOR_VERSION, OGLI_MINOR_VERSION, ctx->profile, ctx->backend);
+
+    for (idx = 0; vars[idx] && used < OGLI_MAX_KEY_LENGTH; idx++)
+    {
+        value = getenv(vars[idx]);
+        if (value)
+            used += snprintf(key + used, OGLI_MAX_KEY_LENGTH - used, "%s=%s;", vars[idx], value);
+    }
+
+#ifdef __linux__
+    if ((ctx->displayName[0] || ctx->screen >= 0) && used < OGLI_MAX_KEY_LENGTH)
+        used += snprintf(key + used, OGLI_MAX_KEY_LENGTH - used, "display=%s screen=%d;", ctx->displayName, ctx->screen);
+#endif /* __linux__ */
+    if (used < OGLI_MAX_KEY_LENGTH)
+        used = ogliCacheKeyLibrary(key, used, (const void *) glGetString, GL_TRUE);
+#ifdef OGLI_USE_EGL
+    if (ctx->backend == OGLI_BACKEND_EGL && used < OGLI_MAX_KEY_LENGTH)
+        used = ogliCacheKeyLibrary(key, used, (const void *) eglGetDisplay, GL_FALSE);
+#endif /* OGLI_USE_EGL */
+
+    if (used >= OGLI_MAX_KEY_LENGTH)
+    {
+        ogliLog("ogliCacheKey: Cache key is too long");
+        return GL_FALSE;
+    }
+    return GL_TRUE;
+}
+
+/* builds the cache file path, creating the cache directory when asked to */
+static GLboolean ogliCachePath(const char * dir, const char * key, char * path, size_t size, GLboolean create)
+{
+    const char  * base;
+    char        folder[1024];
+    GLuint      hash;
+
+    if (dir)
+        snprintf(folder, sizeof(folder), "%s", dir);
+    else if ((base = getenv("XDG_CACHE_HOME")) != NULL && *base)
+        snprintf(folder, sizeof(folder), "%s/glinfo", base);
+    else if ((base = getenv("HOME")) != NULL && *base)
+        snprintf(folder, sizeof(folder), "%s/.cache/glinfo", base);
+    else
+    {
+        ogliLog("ogliCachePath: No cache directory available");
+        return GL_FALSE;
+    }
+
+    if (create)
+    {
+        char * sep;
+        for (sep = strchr(folder + 1, '/'); sep; sep = strchr(sep + 1, '/'))
+        {
+            *sep = '\0';
+            mkdir(folder, 0755);
+            *sep = '/';
+        }
+        mkdir(folder, 0755);
+    }
+
+    hash = ogliHashName(key, (GLuint) strlen(key));
+    snprintf(path, size, "%s/ogli-%08x.cache", folder, hash);
+    return GL_TRUE;
+}
+
+/* a list is only accepted when it fits before 'end' and its offsets describe names separated 
+   as ogliExtListAppend() does, the last one terminated, so that no lookup reads past it */
+static const char * ogliCacheReadList(OGLI_EXT_LIST * list, const char * data, const char * end, GLuint count, GLuint size)
+{
+    size_t  room = (size_t) (end - data);
+    GLuint  idx, next;
+
+    if (count >= room / sizeof(GLuint) || size > room - (count + 1) * sizeof(GLuint))
+        return NULL;
+    if (!ogliExtListAlloc(list, count, size))
+        return NULL;
+
+    memcpy(list->offsets, data, (count + 1) * sizeof(GLuint));
+    memcpy(list->names, data + (count + 1) * sizeof(GLuint), size);
+    list->count = count;
+    list->size = size;
+
+    if (list->offsets[0] != 0 || list->offsets[count] != size)
+        return NULL;
+    for (idx = 0; idx < count; idx++)
+    {
+        next = list->offsets[idx + 1];
+        if (next <= list->offsets[idx] || next > size || list->names[next - 1] != (idx + 1 < count ? ' ' : '\0'))
+            return NULL;
+    }
+    return data + (count + 1) * sizeof(GLuint) + size;
+}
+
+static GLboolean ogliCacheLoadFile(OGLI_CONTEXT * ctx, const char * dir)
+{
+    char                key[OGLI_MAX_KEY_LENGTH], path[1280];
+    OGLI_CACHE_HEADER   header;
+    const char          * data, * tail;
+    struct stat         st;
+    GLboolean           hit = GL_FALSE;
+    int                 fd;
+
+    if (!ogliCacheKey(ctx, key) || !ogliCachePath(dir, key, path, sizeof(path), GL_FALSE))
+        return GL_FALSE;
+
+    fd = open(path, O_RDONLY);
+    if (fd < 0)
+        return GL_FALSE;
+
+    if (fstat(fd, &st) != 0 || st.st_size < (off_t) sizeof(OGLI_CACHE_HEADER))
+    {
+        close(fd);
+        return GL_FALSE;
+    }
+
+    data = (const char *) mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED)
+        return GL_FALSE;
+
+    /* validate the header and the key before trusting any size */
+    memcpy(&header, data, sizeof(OGLI_CACHE_HEADER));
+    if (memcmp(header.magic, OGLI_CACHE_MAGIC, sizeof(header.magic)) == 0 &&
+        header.format == OGLI_CACHE_FORMAT && 
+        header.blockSize == sizeof(GL_INFO_BLOCK) &&
+        header.totalSize == (GLuint) st.st_size &&
+        header.keySize == strlen(key) + 1 &&
+        header.totalSize >= sizeof(OGLI_CACHE_HEADER) + header.keySize + sizeof(GL_INFO_BLOCK) &&
+        memcmp(data + sizeof(OGLI_CACHE_HEADER), key, header.keySize) == 0)
+    {
+        ogliExtListFree(&ctx->iblock.glExtensions);
+        ogliExtListFree(&ctx->iblock.gluExtensions);
+
+        tail = data + sizeof(OGLI_CACHE_HEADER) + header.keySize;
+        memcpy(&ctx->iblock, tail, sizeof(GL_INFO_BLOCK));
+        memset(&ctx->iblock.glExtensions, 0, sizeof(OGLI_EXT_LIST));
+        memset(&ctx->iblock.gluExtensions, 0, sizeof(OGLI_EXT_LIST));
+        tail += sizeof(GL_INFO_BLOCK);
+
+        /* the lists check their counts and offsets, together they fill the rest of the file */
+        tail = ogliCacheReadList(&ctx->iblock.glExtensions, tail, data + header.totalSize, header.glCount, header.glSize);
+        if (tail)
+            tail = ogliCacheReadList(&ctx->iblock.gluExtensions, tail, data + header.totalSize, header.gluCount, header.gluSize);
+        if (tail != data + header.totalSize)
+        {
+            ogliLog("ogliCacheLoad: Invalid extension lists in cache file");
+            ogliExtListFree(&ctx->iblock.glExtensions);
+            ogliExtListFree(&ctx->iblock.gluExtensions);
+        }
+        else
+            hit = ogliIndexBuild(&ctx->extIndex, &ctx->iblock.glExtensions);
+    }
+    else
+        ogliLog("ogliCacheLoad: Stale or invalid cache file");
+
+    munmap((void *) data, st.st_size);
+    return hit;
+}
+
+static GLboolean ogliCacheWrite(FILE * file, const void * data, size_t size)
+{
+    return fwrite(data, 1, size, file) == size;
+}
+
+static GLboolean ogliCacheStoreFile(OGLI_CONTEXT * ctx, const char * dir)
+{
+    char                key[OGLI_MAX_KEY_LENGTH], path[1280], temp[1300];
+    OGLI_CACHE_HEADER   header;
+    const OGLI_EXT_LIST * gl, * glu;
+    GLboolean           done;
+    FILE                * file;
+
+    gl = &ctx->iblock.glExtensions;
+    glu = &ctx->iblock.gluExtensions;
+    if (!gl->offsets || !glu->offsets)
+    {
+        ogliLog("ogliCacheStore: Nothing has been queried");
+        return GL_FALSE;
+    }
+
+    if (!ogliCacheKey(ctx, key) || !ogliCachePath(dir, key, path, sizeof(path), GL_TRUE))
+        return GL_FALSE;
+
+    memset(&header, 0, sizeof(OGLI_CACHE_HEADER));
+    memcpy(header.magic, OGLI_CACHE_MAGIC, sizeof(header.magic));
+    header.format = OGLI_CACHE_FORMAT;
+    header.blockSize = sizeof(GL_INFO_BLOCK);
+    header.keySize = (GLuint) strlen(key) + 1;
+    header.glCount = gl->count;
+    header.glSize = gl->size;
+    header.gluCount = glu->count;
+    header.gluSize = glu->size;
+    header.totalSize = sizeof(OGLI_CACHE_HEADER) + header.keySize + sizeof(GL_INFO_BLOCK) +
+                       (gl->count + 1) * sizeof(GLuint) + gl->size + (glu->count + 1) * sizeof(GLuint) + glu->size;
+
+    /* write to a private file then rename it, readers never see a partial file */
+    snprintf(temp, sizeof(temp), "%s.%d", path, (int) getpid());
+    file = fopen(temp, "wb");
+    if (!file)
+    {
+        ogliLog("ogliCacheStore: Unable to create cache file");
+        return GL_FALSE;
+    }
+
+    done = ogliCacheWrite(file, &header, sizeof(OGLI_CACHE_HEADER)) &&
+           ogliCacheWrite(file, key, header.keySize) &&
+           ogliCacheWrite(file, &ctx->iblock, sizeof(GL_INFO_BLOCK)) &&
+           ogliCacheWrite(file, gl->offsets, (gl->count + 1) * sizeof(GLuint)) &&
+           ogliCacheWrite(file, gl->names, gl->size) &&
+           ogliCacheWrite(file, glu->offsets, (glu->count + 1) * sizeof(GLuint)) &&
+           ogliCacheWrite(file, glu->names, glu->size);
+    done = (fclose(file) == 0) && done;
+
+    if (!done || rename(temp, path) != 0)
+    {
+        ogliLog("ogliCacheStore: Unable to write cache file");
+        unlink(temp);
+        return GL_FALSE;
+    }
+    return GL_TRUE;
+}
+
+#else
+
+static GLboolean ogliCacheLoadFile(OGLI_CONTEXT * ctx, const char * dir)
+{
+    ogliLog("ogliCacheLoad: Capability cache is not supported on this platform");
+    return GL_FALSE;
+}
+
+static GLboolean ogliCacheStoreFile(OGLI_CONTEXT * ctx, const char * dir)
+{
+    ogliLog("ogliCacheStore: Capability cache is not supported on this platform");
+    return GL_FALSE;
+}
+
+#endif /* _WIN32 */
+
+GLboolean ogliCacheLoad(OGLI_CONTEXT * ctx, const char * dir)
+{
+    GLboolean hit;
+
+    if (!ctx)
+    {
+        ogliLog("ogliCacheLoad: Invalid OGLI context");
+        return GL_FALSE;
+    }
+
+    OGLI_BEGIN(ctx, OGLI_PHASE_CACHE);
+    hit = ogliCacheLoadFile(ctx, dir);
+    OGLI_END(ctx, OGLI_PHASE_CACHE);
+    if (hit)
+        ctx->queried = OGLI_Q_ALL;
+    return hit;
+}
+
+GLboolean ogliCacheStore(OGLI_CONTEXT * ctx, const char * dir)
+{
+    GLboolean done;
+
+    if (!ctx)
+    {
+        ogliLog("ogliCacheStore: Invalid OGLI context");
+        return GL_FALSE;
+    }
+
+    /* a later load stands in for a full ogliQuery() */
+    if (ctx->queried != OGLI_Q_ALL)
+    {
+        ogliLog("ogliCacheStore: Information block is incomplete");
+        return GL_FALSE;
+    }
+
+    OGLI_BEGIN(ctx, OGLI_PHASE_CACHE);
+    done = ogliCacheStoreFile(ctx, dir);
+    OGLI_END(ctx, OGLI_PHASE_CACHE);
+    return done;
+}
+
+/*------------------------------------------------------------------------------------------------*/
+/*                                WIN32 PLATFORM SPECIFIC CODE                                    */
+/*------------------------------------------------------------------------------------------------*/
+#ifdef  _WIN32
+
+/* class name and window's title */
+static char * g_WNDCLASS = "LIBOGLI";
+
+GLboolean ogliCreateContext(OGLI_CONTEXT * ctx)
 {
     GLint                   pf;
     WNDCLASS                wc;
     PIXELFORMATDESCRIPTOR   pfd;
 #ifndef OGLI_USE_GLEW
     HGLRC                   rc3;
+    int                     attribs[16];
+#endif /* OGLI_USE_GLEW */
+
+    if (!ctx)    /* validate input parameter */
+    {
+        ogliLog("ogliCreateContext: Invalid OGLI context");
+        return GL_FALSE;
+    }
+
+    /* register our window class */
+    OGLI_BEGIN(ctx, OGLI_PHASE_DISPLAY);
+    memset(&wc, 0, sizeof(WNDCLASS));
+    wc.hInstance = GetModuleHandle(NULL);
+    wc.lpfnWndProc = DefWindowProc;
+    wc.lpszClassName = g_WNDCLASS;
+    if (!RegisterClass(&wc) && GetLastError() != ERROR_CLASS_ALREADY_EXISTS)
+        return GL_FALSE;    /* the class may already be registered by a context on another thread */
+
+    ctx->wnd = CreateWindow(g_WNDCLASS, g_WNDCLASS, 0,  /* create our OpenGL rendering window */
+                            CW_USEDEFAULT, CW_USEDEFAULT, CW_USEDEFAULT, CW_USEDEFAULT, 
+                            NULL, NULL, GetModuleHandle(NULL), NULL);
+    if (!ctx->wnd)
+        return GL_FALSE;
+
+    ctx->dc = GetDC(ctx->wnd);      /* obtain device context */
+    if (!ctx->dc) 
+    {
+        ogliLog("ogliCreateContext: Cannot initialize OGLI library");
+        return GL_FALSE;
+    }
+
+    OGLI_END(ctx, OGLI_PHASE_DISPLAY);
+
+    /* legacy profile */
+    OGLI_BEGIN(ctx, OGLI_PHASE_CONFIG);
+    memset(&pfd, 0, sizeof(PIXELFORMATDESCRIPTOR)); /* preparing to obtain a pixel format */
+    pfd.nSize = sizeof(PIXELFORMATDESCRIPTOR);
+    pfd.nVersion = 1;
+    pfd.dwFlags = PFD_DRAW_TO_WINDOW | PFD_SUPPORT_OPENGL;
+    pf = ChoosePixelFormat(ctx->dc, &pfd);          /* select a pixel format */
+    if (!pf)
+    {
+        ogliLog("ogliCreateContext: Cannot select pixel format");
+        return GL_FALSE;
+    }
+
+    if (!SetPixelFormat(ctx->dc, pf, &pfd))
+    {
+        ogliLog("ogliCreateContext: Pixel format is not accelerated");
+        return GL_FALSE;
+    }
+    OGLI_END(ctx, OGLI_PHASE_CONFIG);
+    
+    /* create rendering context */
+    OGLI_BEGIN(ctx, OGLI_PHASE_CONTEXT);
+    ctx->rc = wglCreateContext(ctx->dc);
+    if (!ctx->rc)
+    {
+        ogliLog("ogliCreateContext: Context creation error");
+        return GL_FALSE;
+    }
+    OGLI_END(ctx, OGLI_PHASE_CONTEXT);
+
+    /* make the rendering context current */
+    OGLI_BEGIN(ctx, OGLI_PHASE_CURRENT);
+    if (!wglMakeCurrent(ctx->dc, ctx->rc))
+    {
+        ogliLog("ogliCreateContext: Error making context current");
+        return GL_FALSE;
+    }
+    OGLI_END(ctx, OGLI_PHASE_CURRENT);
+
+    if (ctx->profile != OGLI_LEGACY)
+    {
+        if (!ogliInitCore(ctx))
+        {
+            ogliLog("ogliCreateContext: Error initialize core profile, switch back to legacy");
+        }
+
+#ifndef OGLI_USE_GLEW
+        if (ctx->createContextAttribs != NULL)
+        {
+            OGLI_BEGIN(ctx, OGLI_PHASE_CONTEXT);
+            ogliContextAttribs(ctx->profile, 3, 2, attribs);
+            rc3 = ctx->createContextAttribs(ctx->dc, 0, attribs);
+            OGLI_END(ctx, OGLI_PHASE_CONTEXT);
+            if (rc3)
+            {
+                wglMakeCurrent(NULL, NULL);
+		        wglDeleteContext(ctx->rc);
+                ctx->rc = rc3;
+		        wglMakeCurrent(ctx->dc, ctx->rc);
+            }
+            else
+                ogliLog("ogliCreateContext: Requested profile is not supported, switch back to legacy");
+        }
+#endif /* OGLI_USE_GLEW */
+    }
+
+    ctx->active = GL_TRUE;
+    ctx->queried = 0;
+    return GL_TRUE;
+}
+
+static GLboolean ogliProbeVersion(OGLI_CONTEXT * ctx, OGLI_PROFILE profile, int major, int minor)
+{
+#ifndef OGLI_USE_GLEW
+    int     attribs[16];
+    HGLRC   rc;
+
+    if (!ctx->createContextAttribs)
+        return GL_FALSE;
+
+    ogliContextAttribs(profile, major, minor, attribs);
+    rc = ctx->createContextAttribs(ctx->dc, 0, attribs);
+    if (!rc)
+        return GL_FALSE;
+
+    wglDeleteContext(rc);
+    return GL_TRUE;
+#else
+    return GL_FALSE;
 #endif /* OGLI_USE_GLEW */
+}
+
+const OGLI_FBCONFIG * ogliQueryFBConfigs(OGLI_CONTEXT * ctx, GLuint * count)
+{
+    ogliLog("ogliQueryFBConfigs: Framebuffer configs are only listed by GLX and EGL");
+    if (count)
+        *count = 0;
+    return NULL;
+}
+
+GLboolean ogliDestroyContext(OGLI_CONTEXT * ctx)
+{
+    if (!ctx)   /* validate input parameter */
+    {
+        ogliLog("ogliDestroyContext: Invalid OGLI context");
+        return GL_FALSE;
+    }
+
+    if (!ctx->active)
+    {
+        ogliLog("ogliDestroyContext: OGLI is not ready");
+        return GL_FALSE;
+    }
+
+    OGLI_BEGIN(ctx, OGLI_PHASE_DESTROY);
+    if (ctx->rc)    /* release the rendering context */
+        wglMakeCurrent(NULL, NULL);
+
+    if (ctx->rc)    /* and destroy it, it is no longer current */
+        wglDeleteContext(ctx->rc);
+    ctx->rc = NULL;
+
+    if (ctx->wnd && ctx->dc)    /* release device context */
+        ReleaseDC(ctx->wnd, ctx->dc);
+
+    if (ctx->wnd)   /* destroy rendering window */
+        DestroyWindow(ctx->wnd);
+    ctx->wnd = NULL;
+    ctx->dc = NULL;
+
+    /* the window class stays registered, windows of other threads may still use it */
+    OGLI_END(ctx, OGLI_PHASE_DESTROY);
+
+    ctx->active = GL_FALSE;
+    return GL_TRUE;
+}
 
-    if (!ctx)    /* validate input parameter */
-    {
+static GLboolean ogliBindContext(OGLI_CONTEXT * ctx, GLboolean bind)
+{
+    return wglMakeCurrent(bind ? ctx->dc : NULL, bind ? ctx->rc : NULL) ? GL_TRUE : GL_FALSE;
+}
+#endif /* _WIN32 */
+
+/*------------------------------------------------------------------------------------------------*/
+/*                                 OSX PLATFORM SPECIFIC CODE                                     */
+/*------------------------------------------------------------------------------------------------*/
+#ifdef __APPLE__
+
+GLboolean ogliCreateContext(OGLI_CONTEXT * ctx)
+{
+    CGLPixelFormatAttribute attribLegacy[] = {kCGLPFAOpenGLProfile, kCGLOGLPVersion_Legacy,   0};
+    CGLPixelFormatAttribute attribCore[] =   {kCGLPFAOpenGLProfile, kCGLOGLPVersion_3_2_Core, 0};
+    CGLError error;
+    CGLPixelFormatObj pf;
+    GLint npix;
+
+    if (!ctx)
+    { 
         ogliLog("ogliCreateContext: Invalid OGLI context");
         return GL_FALSE;
     }
+    
+    /* there is no compatibility profile on OSX, it is served by the legacy profile */
+    OGLI_BEGIN(ctx, OGLI_PHASE_CONFIG);
+    if (ctx->profile == OGLI_CORE || ctx->profile == OGLI_FORWARD)
+    {
+        /* attempt to select core profile, core contexts are always forward-compatible */
+        error = CGLChoosePixelFormat(attribCore, &pf, &npix);
+        if (error)
+        {
+            /* if core profile request failed, going back to legacy profile */
+            error = CGLChoosePixelFormat(attribLegacy, &pf, &npix);
+            if (error)
+                return GL_FALSE;        /* still no? */
+        }
+    }
+    else
+        CGLChoosePixelFormat(attribLegacy, &pf, &npix);
+    OGLI_END(ctx, OGLI_PHASE_CONFIG);
 
-    /* register our window class */
-    memset(&wc, 0, sizeof(WNDCLASS));
-    wc.hInstance = GetModuleHandle(NULL);
-    wc.lpfnWndProc = DefWindowProc;
-    wc.lpszClassName = g_WNDCLASS;
-    if (!RegisterClass(&wc))
+    OGLI_BEGIN(ctx, OGLI_PHASE_CONTEXT);
+    CGLCreateContext(pf, NULL, &ctx->context);
+    OGLI_END(ctx, OGLI_PHASE_CONTEXT);
+    OGLI_BEGIN(ctx, OGLI_PHASE_CURRENT);
+    ctx->contextOrig = CGLGetCurrentContext();
+    CGLSetCurrentContext(ctx->context);
+    OGLI_END(ctx, OGLI_PHASE_CURRENT);
+    CGLReleasePixelFormat(pf);
+
+    /* get glGetStringi entry point if core profile is requested */
+    if (ctx->profile != OGLI_LEGACY)
+    {
+        if (!ogliInitCore(ctx))
+            return GL_FALSE;
+    }
+
+    ctx->active = GL_TRUE;
+    ctx->queried = 0;
+
+    return GL_TRUE;
+}
+
+/* CGL only knows the 3.2 and 4.x core profiles, 4.x being 4.1 on every shipping system */
+static GLboolean ogliProbeVersion(OGLI_CONTEXT * ctx, OGLI_PROFILE profile, int major, int minor)
+{
+    CGLPixelFormatAttribute attribs[] = {kCGLPFAOpenGLProfile, kCGLOGLPVersion_3_2_Core, 0};
+    CGLPixelFormatObj pf;
+    GLint npix;
+
+    (void) ctx;
+    if (profile != OGLI_CORE || major > 4 || (major == 4 && minor > 1))
         return GL_FALSE;
+    if (major == 4 || minor > 2)
+        attribs[1] = kCGLOGLPVersion_GL4_Core;
 
-    ctx->wnd = CreateWindow(g_WNDCLASS, g_WNDCLASS, 0,  /* create our OpenGL rendering window */
-                            CW_USEDEFAULT, CW_USEDEFAULT, CW_USEDEFAULT, CW_USEDEFAULT, 
-                            NULL, NULL, GetModuleHandle(NULL), NULL);
-    if (!ctx->wnd)
+    if (CGLChoosePixelFormat(attribs, &pf, &npix) || !pf)
         return GL_FALSE;
 
-    ctx->dc = GetDC(ctx->wnd);      /* obtain device context */
-    if (!ctx->dc) 
+    CGLReleasePixelFormat(pf);
+    return GL_TRUE;
+}
+
+const OGLI_FBCONFIG * ogliQueryFBConfigs(OGLI_CONTEXT * ctx, GLuint * count)
+{
+    ogliLog("ogliQueryFBConfigs: Framebuffer configs are only listed by GLX and EGL");
+    if (count)
+        *count = 0;
+    return NULL;
+}
+
+GLboolean ogliDestroyContext(OGLI_CONTEXT * ctx)
+{
+    if (!ctx)
     {
-        ogliLog("ogliCreateContext: Cannot initialize OGLI library");
+        ogliLog("ogliDestroyContext: Invalid OGLI context"); 
         return GL_FALSE;
     }
 
-    /* legacy profile */
-    memset(&pfd, 0, sizeof(PIXELFORMATDESCRIPTOR)); /* preparing to obtain a pixel format */
-    pfd.nSize = sizeof(PIXELFORMATDESCRIPTOR);
-    pfd.nVersion = 1;
-    pfd.dwFlags = PFD_DRAW_TO_WINDOW | PFD_SUPPORT_OPENGL;
-    pf = ChoosePixelFormat(ctx->dc, &pfd);          /* select a pixel format */
-    if (!pf)
+    OGLI_BEGIN(ctx, OGLI_PHASE_DESTROY);
+    CGLSetCurrentContext(ctx->contextOrig);
+    if (ctx->context) 
+        CGLReleaseContext(ctx->context);
+    OGLI_END(ctx, OGLI_PHASE_DESTROY);
+
+    ctx->active = GL_FALSE;
+    return GL_TRUE;
+}
+
+static GLboolean ogliBindContext(OGLI_CONTEXT * ctx, GLboolean bind)
+{
+    return CGLSetCurrentContext(bind ? ctx->context : NULL) == kCGLNoError ? GL_TRUE : GL_FALSE;
+}
+#endif /* __APPLE__ */
+
+/*------------------------------------------------------------------------------------------------*/
+/*                                LINUX PLATFORM SPECIFIC CODE                                    */
+/*------------------------------------------------------------------------------------------------*/
+#ifdef __linux__
+
+/* 
+** NOTES
+** -----
+** To enable OpenGL 3.2 core profile emulation with MESA on unsupported platforms, 
+** use the following command in your terminal:
+** 
+** $LIBGL_ALWAYS_SOFTWARE=1 bin/glinfo -c
+**
+*/
+
+/* screen selected by ogliSetDisplay() */
+#define ogliScreen(ctx)     ((ctx)->screen >= 0 ? (ctx)->screen : DefaultScreen((ctx)->display))
+
+typedef GLXContext (*glXCreateContextAttribsARBProc)(Display*, GLXFBConfig, GLXContext, Bool, const int *);
+
+/*
+** X errors raised while creating the context are trapped instead of terminating the process.
+** The handler is process wide, so it is installed once and never swapped. Each context owns
+** its trap and an error only marks the contexts trapping on the display that raised it, so
+** contexts on other threads and displays never see it.
+*/
+static pthread_mutex_t  ctxTrapLock = PTHREAD_MUTEX_INITIALIZER;
+static OGLI_CONTEXT     * ctxTraps = NULL;
+static int (*ctxOldHandler)(Display*, XErrorEvent*) = NULL;
+
+static int ctxErrorHandler(Display *dpy, XErrorEvent * ev)
+{
+    OGLI_CONTEXT    * ctx;
+    GLboolean       trapped = GL_FALSE;
+
+    pthread_mutex_lock(&ctxTrapLock);
+    for (ctx = ctxTraps; ctx; ctx = ctx->nextTrap)
     {
-        ogliLog("ogliCreateContext: Cannot select pixel format");
+        if (ctx->display == dpy)
+        {
+            ctx->errorOccurred = GL_TRUE;
+            trapped = GL_TRUE;
+        }
+    }
+    pthread_mutex_unlock(&ctxTrapLock);
+
+    if (!trapped)
+        return ctxOldHandler ? ctxOldHandler(dpy, ev) : 0;
+    return 0;
+}
+
+static void ogliTrapErrors(OGLI_CONTEXT * ctx)
+{
+    XSync(ctx->display, GL_FALSE);
+    pthread_mutex_lock(&ctxTrapLock);
+    ctx->errorOccurred = GL_FALSE;
+    ctx->nextTrap = ctxTraps;
+    ctxTraps = ctx;
+    pthread_mutex_unlock(&ctxTrapLock);
+}
+
+static GLboolean ogliUntrapErrors(OGLI_CONTEXT * ctx)
+{
+    OGLI_CONTEXT ** link;
+
+    XSync(ctx->display, GL_FALSE);
+    pthread_mutex_lock(&ctxTrapLock);
+    for (link = &ctxTraps; *link; link = &(*link)->nextTrap)
+    {
+        if (*link == ctx)
+        {
+            *link = ctx->nextTrap;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&ctxTrapLock);
+    return ctx->errorOccurred;
+}
+
+/* GLX_MESA_query_renderer attributes */
+#define OGLI_RENDERER_VENDOR_ID         0x8183
+#define OGLI_RENDERER_DEVICE_ID         0x8184
+#define OGLI_RENDERER_ACCELERATED       0x8186
+#define OGLI_RENDERER_VIDEO_MEMORY      0x8187
+#define OGLI_RENDERER_UNIFIED_MEMORY    0x8188
+#define OGLI_RENDERER_CORE_VERSION      0x818A
+#define OGLI_RENDERER_COMPAT_VERSION    0x818B
+
+typedef Bool (*glXQueryRendererIntegerMESAProc)(Display*, int, int, int, unsigned int *);
+typedef const char * (*glXQueryRendererStringMESAProc)(Display*, int, int, int);
+
+/* the first renderer of the screen, from the display of the context or a display of its own */
+static GLboolean ogliQueryRendererGLX(OGLI_CONTEXT * ctx)
+{
+    glXQueryRendererIntegerMESAProc queryInteger;
+    glXQueryRendererStringMESAProc  queryString;
+    OGLI_RENDERER   * renderer = &ctx->iblock.renderer;
+    Display         * display = ctx->active ? ctx->display : NULL;
+    const char      * text, * glxExts = NULL;
+    unsigned int    value[2];
+    int             screen;
+
+    if (!display)
+    {
+        display = XOpenDisplay(ctx->displayName[0] ? ctx->displayName : NULL);
+        if (!display)
+        {
+            ogliLog("ogliQueryRenderer: Failed to open X display");
+            return GL_FALSE;
+        }
+    }
+
+    screen = ctx->screen >= 0 ? ctx->screen : DefaultScreen(display);
+    queryInteger = (glXQueryRendererIntegerMESAProc) glXGetProcAddressARB((const GLubyte *) "glXQueryRendererIntegerMESA");
+    queryString = (glXQueryRendererStringMESAProc) glXGetProcAddressARB((const GLubyte *) "glXQueryRendererStringMESA");
+
+    /* a screen without GLX has no extension string */
+    if (screen < ScreenCount(display))
+        glxExts = glXQueryExtensionsString(display, screen);
+    if (glxExts && queryInteger && queryString && checkExtension(glxExts, "GLX_MESA_query_renderer") &&
+        queryInteger(display, screen, 0, OGLI_RENDERER_VENDOR_ID, value))
+    {
+        renderer->vendorId = value[0];
+        if (queryInteger(display, screen, 0, OGLI_RENDERER_DEVICE_ID, value))
+            renderer->deviceId = value[0];
+        if (queryInteger(display, screen, 0, OGLI_RENDERER_VIDEO_MEMORY, value))
+            renderer->videoMemory = value[0];
+        if (queryInteger(display, screen, 0, OGLI_RENDERER_ACCELERATED, value))
+            renderer->accelerated = value[0] ? GL_TRUE : GL_FALSE;
+        if (queryInteger(display, screen, 0, OGLI_RENDERER_UNIFIED_MEMORY, value))
+            renderer->unifiedMemory = value[0] ? GL_TRUE : GL_FALSE;
+        if (queryInteger(display, screen, 0, OGLI_RENDERER_CORE_VERSION, value))
+        {
+            ctx->iblock.maxCore.major = value[0];
+            ctx->iblock.maxCore.minor = value[1];
+        }
+        if (queryInteger(display, screen, 0, OGLI_RENDERER_COMPAT_VERSION, value))
+        {
+            ctx->iblock.maxCompat.major = value[0];
+            ctx->iblock.maxCompat.minor = value[1];
+        }
+
+        /* an active context already holds the strings of glGetString() */
+        if (!ctx->active)
+        {
+            text = queryString(display, screen, 0, OGLI_RENDERER_VENDOR_ID);
+            if (text)
+                strncpy(ctx->iblock.glVendor, text, OGLI_MAX_INFO_LENGTH-1);
+            text = queryString(display, screen, 0, OGLI_RENDERER_DEVICE_ID);
+            if (text)
+                strncpy(ctx->iblock.glRenderer, text, OGLI_MAX_INFO_LENGTH-1);
+        }
+        renderer->source = ctx->active ? OGLI_RENDERER_CONTEXT : OGLI_RENDERER_DISPLAY;
+    }
+
+    if (!ctx->active)
+        XCloseDisplay(display);
+    return renderer->source != OGLI_RENDERER_NONE;
+}
+
+/* called once per process, before any other Xlib call of the library */
+static void ogliInitXlib(void)
+{
+    XInitThreads();
+    ctxOldHandler = XSetErrorHandler(&ctxErrorHandler);
+}
+
+/* try to make the context current without a drawable (GLX_ARB_create_context) */
+static GLboolean ogliMakeCurrentNoDrawable(OGLI_CONTEXT * ctx, const char * glxExts)
+{
+    Bool done;
+
+    if (!checkExtension(glxExts, "GLX_ARB_create_context"))
+        return GL_FALSE;
+
+    ogliTrapErrors(ctx);
+    done = glXMakeContextCurrent(ctx->display, None, None, ctx->context);
+    if (ogliUntrapErrors(ctx) || !done)
+    {
+        ogliLog("ogliCreateContext: Context cannot be made current without a drawable");
+        return GL_FALSE;
+    }
+
+    ctx->drawable = OGLI_DRAWABLE_NONE;
+    return GL_TRUE;
+}
+
+/* try to make the context current on a tiny offscreen pbuffer */
+static GLboolean ogliMakeCurrentPbuffer(OGLI_CONTEXT * ctx, GLXFBConfig fbc)
+{
+    static const int pbuffer_attribs[] =
+    {
+        GLX_PBUFFER_WIDTH   , 1,
+        GLX_PBUFFER_HEIGHT  , 1,
+        None
+    };
+    int drawableType = 0;
+    Bool done;
+
+    glXGetFBConfigAttrib(ctx->display, fbc, GLX_DRAWABLE_TYPE, &drawableType);
+    if (!(drawableType & GLX_PBUFFER_BIT))
+        return GL_FALSE;
+
+    ogliTrapErrors(ctx);
+    ctx->pbuffer = glXCreatePbuffer(ctx->display, fbc, pbuffer_attribs);
+    done = ctx->pbuffer && glXMakeContextCurrent(ctx->display, ctx->pbuffer, ctx->pbuffer, ctx->context);
+    if (ogliUntrapErrors(ctx) || !done)
+    {
+        ogliLog("ogliCreateContext: Context cannot be made current on a pbuffer");
+        if (ctx->pbuffer)
+            glXDestroyPbuffer(ctx->display, ctx->pbuffer);
+        ctx->pbuffer = 0;
+        return GL_FALSE;
+    }
+
+    ctx->drawable = OGLI_DRAWABLE_PBUFFER;
+    return GL_TRUE;
+}
+
+/* create a tiny window and make the context current on it, the window is only mapped 
+   when windowless mode is not requested */
+static GLboolean ogliMakeCurrentWindow(OGLI_CONTEXT * ctx, GLXFBConfig fbc)
+{
+    XVisualInfo *vi = glXGetVisualFromFBConfig(ctx->display, fbc);
+    XSetWindowAttributes swa;
+
+    if (!vi)
+    {
+        ogliLog("ogliCreateContext: Framebuffer config has no visual");
+        return GL_FALSE;
+    }
+
+    swa.colormap = ctx->cmap = XCreateColormap(ctx->display, RootWindow(ctx->display, vi->screen), vi->visual, AllocNone);
+    swa.background_pixmap = None;
+    swa.border_pixel      = 0;
+    swa.event_mask        = StructureNotifyMask;
+
+    ctx->win = XCreateWindow( ctx->display, RootWindow( ctx->display, vi->screen ), 
+                              0, 0, 10, 10, 0, vi->depth, InputOutput, 
+                              vi->visual, CWBorderPixel|CWColormap|CWEventMask, &swa );
+    XFree(vi);
+    if (!ctx->win)
+    {
+        ogliLog("ogliCreateContext: Error creating window");
         return GL_FALSE;
     }
 
-    if (!SetPixelFormat(ctx->dc, pf, &pfd))
+    if (!ctx->windowless)
+        XMapWindow(ctx->display, ctx->win);
+
+    ctx->drawable = OGLI_DRAWABLE_WINDOW;
+    return glXMakeCurrent(ctx->display, ctx->win, ctx->context) ? GL_TRUE : GL_FALSE;
+}
+
+/* makes the context current again on the drawable it was created with, or releases it */
+static GLboolean ogliBindContext(OGLI_CONTEXT * ctx, GLboolean bind)
+{
+    Bool done;
+
+#ifdef OGLI_USE_EGL
+    if (ctx->backend == OGLI_BACKEND_EGL)
+        return eglMakeCurrent(ctx->eglDisplay, EGL_NO_SURFACE, EGL_NO_SURFACE, 
+                              bind ? ctx->eglContext : EGL_NO_CONTEXT) ? GL_TRUE : GL_FALSE;
+#endif /* OGLI_USE_EGL */
+
+    if (!bind)
+        done = glXMakeContextCurrent(ctx->display, None, None, NULL);
+    else if (ctx->drawable == OGLI_DRAWABLE_NONE)
+        done = glXMakeContextCurrent(ctx->display, None, None, ctx->context);
+    else if (ctx->drawable == OGLI_DRAWABLE_PBUFFER)
+        done = glXMakeContextCurrent(ctx->display, ctx->pbuffer, ctx->pbuffer, ctx->context);
+    else
+        done = glXMakeCurrent(ctx->display, ctx->win, ctx->context);
+    return done ? GL_TRUE : GL_FALSE;
+}
+
+/* a pooled context is made current on the drawable the pool holds for its profile */
+static GLboolean ogliMakeCurrentPooled(OGLI_CONTEXT * ctx)
+{
+    OGLI_POOL * pool = ctx->pool;
+
+    ctx->drawable = pool->drawable[ctx->profile];
+    ctx->win = pool->win[ctx->profile];
+    ctx->cmap = pool->cmap[ctx->profile];
+    ctx->pbuffer = pool->pbuffer[ctx->profile];
+    return ogliBindContext(ctx, GL_TRUE);
+}
+
+static GLboolean ogliDestroyContextGLX(OGLI_CONTEXT * ctx);
+
+/* undoes a context creation that failed before the context became active, the display and 
+   drawable of a pool are kept */
+static GLboolean ogliAbortContextGLX(OGLI_CONTEXT * ctx)
+{
+    if (ctx->context)
+        ogliDestroyContextGLX(ctx);
+    else if (!ctx->pool || ctx->display != ctx->pool->display)
+        XCloseDisplay(ctx->display);
+    ctx->context = 0;
+    ctx->display = NULL;
+    return GL_FALSE;
+}
+
+static GLboolean ogliCreateContextGLX(OGLI_CONTEXT * ctx)
+{
+    OGLI_POOL * pool = ctx->pool;
+    /* framebuffer desired config, a query needs no depth, stencil, multisampling nor double 
+       buffering: the first match is as good as any and no config has to be inspected */
+    int visual_attribs[] =
+    {
+        GLX_X_RENDERABLE    , GL_TRUE,
+        GLX_DRAWABLE_TYPE   , GLX_WINDOW_BIT,
+        GLX_RENDER_TYPE     , GLX_RGBA_BIT,
+        GLX_X_VISUAL_TYPE   , GLX_TRUE_COLOR,
+        None
+    };
+    int glx_major, glx_minor;
+    GLXFBConfig* fbc = NULL;
+    int fbcount = 0;
+
+    ctx->context = 0;
+
+    /* the display of a pool has been checked when its first context was created */
+    OGLI_BEGIN(ctx, OGLI_PHASE_DISPLAY);
+    if (pool && pool->display)
+        ctx->display = pool->display;
+    else
+    {
+        ctx->display = XOpenDisplay(ctx->displayName[0] ? ctx->displayName : NULL);
+        if (!ctx->display)
+        {
+            ogliLog("ogliCreateContext: Failed to open X display\n");
+            return GL_FALSE;
+        }
+
+        if (ctx->screen >= ScreenCount(ctx->display))
+        {
+            ogliLog("ogliCreateContext: Screen does not exist on the X display");
+            return ogliAbortContextGLX(ctx);
+        }
+ 
+        /* FBConfigs were added in GLX version 1.3. */
+        if (!glXQueryVersion(ctx->display, &glx_major, &glx_minor) || 
+           ((glx_major == 1) && (glx_minor < 3)) || (glx_major < 1))
+        {
+            ogliLog("ogliCreateContext: Unsupported GLX version");
+            return ogliAbortContextGLX(ctx);
+        }
+    }
+    OGLI_END(ctx, OGLI_PHASE_DISPLAY);
+
+    /* in windowless mode, prefer configs that can also back a pbuffer */
+    OGLI_BEGIN(ctx, OGLI_PHASE_CONFIG);
+    if (pool && pool->adopted[ctx->profile])
+        ctx->fbconfig = pool->fbconfig[ctx->profile];
+    else
+    {
+        if (ctx->windowless)
+        {
+            visual_attribs[3] = GLX_WINDOW_BIT | GLX_PBUFFER_BIT;
+            fbc = glXChooseFBConfig(ctx->display, ogliScreen(ctx), visual_attribs, &fbcount);
+            visual_attribs[3] = GLX_WINDOW_BIT;
+        }
+        if (!fbc)
+            fbc = glXChooseFBConfig(ctx->display, ogliScreen(ctx), visual_attribs, &fbcount);
+        if (!fbc)
+        {
+            ogliLog("ogliCreateContext: Unable to obtain a framebuffer config");
+            return ogliAbortContextGLX(ctx);
+        }
+
+        /* configs are sorted by the server, caveat free and single sampled configs come first */
+        ctx->fbconfig = fbc[0];
+        XFree(fbc);
+    }
+    GLXFBConfig bestFbc = ctx->fbconfig;
+    OGLI_END(ctx, OGLI_PHASE_CONFIG);
+
+    /* Get the default screen's GLX extension list */
+    const char *glxExts = glXQueryExtensionsString(ctx->display, ogliScreen(ctx));
+
+    OGLI_BEGIN(ctx, OGLI_PHASE_CONTEXT);
+    ctx->createContextAttribs = (glXCreateContextAttribsARBProc)
+    glXGetProcAddressARB((const GLubyte *) "glXCreateContextAttribsARB");
+    ctx->context = 0;
+    ogliTrapErrors(ctx);
+
+    if (ctx->profile != OGLI_LEGACY)
     {
-        ogliLog("ogliCreateContext: Pixel format is not accelerated");
-        return GL_FALSE;
+        if (!checkExtension(glxExts, "GLX_ARB_create_context") ||
+            !ctx->createContextAttribs)
+        {
+            ogliUntrapErrors(ctx);
+            ogliLog("ogliCreateContext: GLX_ARB_create_context is not supported");
+            return ogliAbortContextGLX(ctx);
+        }
+
+        int context_attribs[16];
+        ogliContextAttribs(ctx->profile, 3, 2, context_attribs);   /* request OpenGL 3.2 */
+        ctx->context = ctx->createContextAttribs(ctx->display, bestFbc, 0, GL_TRUE, context_attribs);
     }
-    
-    /* create rendering context */
-    ctx->rc = wglCreateContext(ctx->dc);
-    if (!ctx->rc)
+    else
     {
-        ogliLog("ogliCreateContext: Context creation error");
-        return GL_FALSE;
+        ctx->context = glXCreateNewContext(ctx->display, bestFbc, GLX_RGBA_TYPE, 0, GL_TRUE);
     }
 
-    /* make the rendering context current */
-    if (!wglMakeCurrent(ctx->dc, ctx->rc))
+    if (ogliUntrapErrors(ctx) || !ctx->context)
     {
-        ogliLog("ogliCreateContext: Error making context current");
-        return GL_FALSE;
+        ogliLog("ogliCreateContext: Unable to create OpenGL context");
+        return ogliAbortContextGLX(ctx);
     }
+    OGLI_END(ctx, OGLI_PHASE_CONTEXT);
 
-    if (ctx->profile == OGLI_CORE)
+    /* windowless mode falls back from no drawable, to pbuffer, then to an unmapped window */
+    OGLI_BEGIN(ctx, OGLI_PHASE_CURRENT);
+    if (pool && pool->adopted[ctx->profile])
     {
-        if (!ogliInitCore())
+        if (!ogliMakeCurrentPooled(ctx))
         {
-            ogliLog("ogliCreateContext: Error initialize core profile, switch back to legacy");
+            ogliLog("ogliCreateContext: Error making context current on the drawable of the pool");
+            return ogliAbortContextGLX(ctx);
         }
-
-#ifndef OGLI_USE_GLEW
-        if (wglCreateContextAttribsARB != NULL)
+    }
+    else if (!ctx->windowless || (!ogliMakeCurrentNoDrawable(ctx, glxExts) && 
+                                  !ogliMakeCurrentPbuffer(ctx, bestFbc)))
+    {
+        if (!ogliMakeCurrentWindow(ctx, bestFbc))
         {
-            rc3 = wglCreateContextAttribsARB(ctx->dc, 0, NULL);
-            wglMakeCurrent(NULL, NULL);
-		    wglDeleteContext(ctx->rc);
-            ctx->rc = rc3;
-		    wglMakeCurrent(ctx->dc, ctx->rc);
+            ogliLog("ogliCreateContext: Error making context current");
+            return ogliAbortContextGLX(ctx);
         }
-#endif /* OGLI_USE_GLEW */
     }
+    OGLI_END(ctx, OGLI_PHASE_CURRENT);
 
     ctx->active = GL_TRUE;
+    ctx->queried = 0;
+    if (ctx->profile != OGLI_LEGACY)
+    {
+        if (!ogliInitCore(ctx))
+            return GL_FALSE;
+    }
+
     return GL_TRUE;
 }
 
-GLboolean ogliDestroyContext(OGLI_CONTEXT * ctx)
+/* every failed probe costs an X error round-trip, hence the ladder search */
+static GLboolean ogliProbeVersionGLX(OGLI_CONTEXT * ctx, OGLI_PROFILE profile, int major, int minor)
 {
-    if (!ctx)   /* validate input parameter */
-    {
-        ogliLog("ogliDestroyContext: Invalid OGLI context");
-        return GL_FALSE;
-    }
+    const char * glxExts = glXQueryExtensionsString(ctx->display, ogliScreen(ctx));
+    GLXContext probe;
+    GLboolean failed;
+    int attribs[16];
 
-    if (!ctx->active)
-    {
-        ogliLog("ogliDestroyContext: OGLI is not ready");
+    if (!ctx->createContextAttribs || !checkExtension(glxExts, "GLX_ARB_create_context_profile"))
         return GL_FALSE;
-    }
-
-    if (ctx->rc)    /* release the rendering context */
-        wglMakeCurrent(NULL, NULL);
-
-    if (ctx->rc)    /* and destroy it */
-        wglDeleteContext(wglGetCurrentContext());
-
-    if (ctx->wnd && ctx->dc)    /* release device context */
-        ReleaseDC(ctx->wnd, ctx->dc);
 
-    if (ctx->wnd)   /* destroy rendering window */
-        DestroyWindow(ctx->wnd);
-  
-    /* and unregister window class from the system */
-    UnregisterClass(g_WNDCLASS, GetModuleHandle(NULL));  
+    ogliContextAttribs(profile, major, minor, attribs);
+    ogliTrapErrors(ctx);
+    probe = ctx->createContextAttribs(ctx->display, ctx->fbconfig, 0, GL_TRUE, attribs);
+    failed = ogliUntrapErrors(ctx);
+    if (probe)
+        glXDestroyContext(ctx->display, probe);
 
-    ctx->active = GL_FALSE;
-    return GL_TRUE;
+    return !failed && probe;
 }
-#endif /* _WIN32 */
 
-/*------------------------------------------------------------------------------------------------*/
-/*                                 OSX PLATFORM SPECIFIC CODE                                     */
-/*------------------------------------------------------------------------------------------------*/
-#ifdef __APPLE__
+#define GLX_FRAMEBUFFER_SRGB_CAPABLE    0x20B2
 
-GLboolean ogliCreateContext(OGLI_CONTEXT * ctx)
+static const OGLI_FBCONFIG_ATTRIB ogliFBConfigAttribsGLX[] =
 {
-    CGLPixelFormatAttribute attribLegacy[] = {kCGLPFAOpenGLProfile, kCGLOGLPVersion_Legacy,   0};
-    CGLPixelFormatAttribute attribCore[] =   {kCGLPFAOpenGLProfile, kCGLOGLPVersion_3_2_Core, 0};
-    CGLError error;
-    CGLPixelFormatObj pf;
-    GLint npix;
-
-    if (!ctx)
-    { 
-        ogliLog("ogliCreateContext: Invalid OGLI context");
+    {GLX_FBCONFIG_ID                , offsetof(OGLI_FBCONFIG, id)},
+    {GLX_VISUAL_ID                  , offsetof(OGLI_FBCONFIG, visualId)},
+    {GLX_RED_SIZE                   , offsetof(OGLI_FBCONFIG, red)},
+    {GLX_GREEN_SIZE                 , offsetof(OGLI_FBCONFIG, green)},
+    {GLX_BLUE_SIZE                  , offsetof(OGLI_FBCONFIG, blue)},
+    {GLX_ALPHA_SIZE                 , offsetof(OGLI_FBCONFIG, alpha)},
+    {GLX_DEPTH_SIZE                 , offsetof(OGLI_FBCONFIG, depth)},
+    {GLX_STENCIL_SIZE               , offsetof(OGLI_FBCONFIG, stencil)},
+    {GLX_SAMPLES                    , offsetof(OGLI_FBCONFIG, samples)},
+    {GLX_DOUBLEBUFFER               , offsetof(OGLI_FBCONFIG, doubleBuffer)},
+    {GLX_STEREO                     , offsetof(OGLI_FBCONFIG, stereo)},
+    {GLX_FRAMEBUFFER_SRGB_CAPABLE   , offsetof(OGLI_FBCONFIG, sRGB)},
+    {GLX_DRAWABLE_TYPE              , offsetof(OGLI_FBCONFIG, drawables)},
+    {GLX_CONFIG_CAVEAT              , offsetof(OGLI_FBCONFIG, caveat)}
+};
+
+/* glXGetFBConfigs() transfers the attributes of every config in a single request, the 
+   attributes are then read from the client side copy */
+static GLboolean ogliQueryFBConfigsGLX(OGLI_CONTEXT * ctx)
+{
+    const OGLI_FBCONFIG_ATTRIB * attrib;
+    OGLI_FBCONFIG   * config;
+    GLXFBConfig     * fbc;
+    int             count = 0, idx;
+    size_t          field;
+
+    fbc = glXGetFBConfigs(ctx->display, ogliScreen(ctx), &count);
+    if (!ogliAllocFBConfigs(ctx, count))
+    {
+        if (fbc)
+            XFree(fbc);
         return GL_FALSE;
     }
-    
-    if (ctx->profile == OGLI_CORE)
+
+    for (idx = 0; idx < count; idx++)
     {
-        /* attempt to select core profile */
-        error = CGLChoosePixelFormat(attribCore, &pf, &npix);
-        if (error)
+        config = &ctx->fbconfigs[idx];
+        for (field = 0; field < sizeof(ogliFBConfigAttribsGLX) / sizeof(ogliFBConfigAttribsGLX[0]); field++)
         {
-            /* if core profile request failed, going back to legacy profile */
-            error = CGLChoosePixelFormat(attribLegacy, &pf, &npix);
-            if (error)
-                return GL_FALSE;        /* still no? */
+            attrib = &ogliFBConfigAttribsGLX[field];
+            if (glXGetFBConfigAttrib(ctx->display, fbc[idx], attrib->attrib, OGLI_FBCONFIG_FIELD(config, attrib)) != Success)
+                *OGLI_FBCONFIG_FIELD(config, attrib) = 0;
         }
-    }
-    else
-        CGLChoosePixelFormat(attribLegacy, &pf, &npix);
-
-    CGLCreateContext(pf, NULL, &ctx->context);
-    ctx->contextOrig = CGLGetCurrentContext();
-    CGLSetCurrentContext(ctx->context);
-    CGLReleasePixelFormat(pf);
 
-    /* get glGetStringi entry point if core profile is requested */
-    if (ctx->profile == OGLI_CORE)
-    {
-        if (!ogliInitCore())
-            return GL_FALSE;
+        /* drawable bits are the same as the library ones */
+        config->drawables &= OGLI_FBCONFIG_WINDOW | OGLI_FBCONFIG_PIXMAP | OGLI_FBCONFIG_PBUFFER;
+        config->caveat = config->caveat == GLX_SLOW_CONFIG ? OGLI_CAVEAT_SLOW :
+                         config->caveat == GLX_NON_CONFORMANT_CONFIG ? OGLI_CAVEAT_NON_CONFORMANT : OGLI_CAVEAT_NONE;
     }
 
-    ctx->active = GL_TRUE;
-
+    if (fbc)
+        XFree(fbc);
+    ctx->totalFBConfigs = count;
     return GL_TRUE;
 }
 
-GLboolean ogliDestroyContext(OGLI_CONTEXT * ctx)
+static GLboolean ogliDestroyContextGLX(OGLI_CONTEXT * ctx)
 {
-    if (!ctx)
+    OGLI_POOL * pool = ctx->pool;
+
+    /* an idle context of a pool is not current, another one of the pool may be */
+    if (!pool || glXGetCurrentContext() == ctx->context)
+        glXMakeCurrent(ctx->display, 0, 0);
+    glXDestroyContext(ctx->display, ctx->context);
+
+    /* only what the pool has adopted belongs to it, the first context of a profile can fail 
+       before handing its drawable and display over */
+    if (ctx->pbuffer && (!pool || ctx->pbuffer != pool->pbuffer[ctx->profile]))
+        glXDestroyPbuffer(ctx->display, ctx->pbuffer);
+    if (ctx->win && (!pool || ctx->win != pool->win[ctx->profile]))
     {
-        ogliLog("ogliDestroyContext: Invalid OGLI context"); 
-        return GL_FALSE;
+        XDestroyWindow(ctx->display, ctx->win);
+        XFreeColormap(ctx->display, ctx->cmap);
     }
+    if (!pool || ctx->display != pool->display)
+        XCloseDisplay(ctx->display);
 
-    CGLSetCurrentContext(ctx->contextOrig);
-    if (ctx->context) 
-        CGLReleaseContext(ctx->context);
-
+    ctx->pbuffer = 0;
+    ctx->win = 0;
+    ctx->cmap = 0;
     ctx->active = GL_FALSE;
+
     return GL_TRUE;
 }
-#endif /* __APPLE__ */
 
-/*------------------------------------------------------------------------------------------------*/
-/*                                LINUX PLATFORM SPECIFIC CODE                                    */
-/*------------------------------------------------------------------------------------------------*/
-#ifdef __linux__
+#ifdef OGLI_USE_EGL
 
-/* 
+/*
 ** NOTES
 ** -----
-** To enable OpenGL 3.2 core profile emulation with MESA on unsupported platforms, 
-** use the following command in your terminal:
-** 
-** $LIBGL_ALWAYS_SOFTWARE=1 bin/glinfo -c
+** The EGL backend creates a surfaceless context on the MESA surfaceless platform, hence no 
+** display server, no window and no X round-trips are required. It works with llvmpipe on 
+** headless render nodes:
+**
+** $LIBGL_ALWAYS_SOFTWARE=1 bin/glinfo --backend=egl
 **
 */
 
-#define GLX_CONTEXT_MAJOR_VERSION_ARB	0x2091
-#define	GLX_CONTEXT_MINOR_VERSION_ARB	0x2092
+/* the surfaceless display is shared by every context of the process and EGL does not count 
+   initializations, the library does so that a display in use is never terminated */
+static pthread_mutex_t  eglDisplayLock = PTHREAD_MUTEX_INITIALIZER;
+static GLuint           eglDisplayRefs = 0;
 
-typedef GLXContext (*glXCreateContextAttribsARBProc)(Display*, GLXFBConfig, GLXContext, Bool, const int *);
-static GLboolean ctxErrorOccurred = GL_FALSE;
+static GLboolean ogliAcquireDisplayEGL(EGLDisplay dpy, EGLint * major, EGLint * minor)
+{
+    GLboolean done;
+
+    pthread_mutex_lock(&eglDisplayLock);
+    done = eglInitialize(dpy, major, minor) ? GL_TRUE : GL_FALSE;
+    if (done)
+        eglDisplayRefs++;
+    pthread_mutex_unlock(&eglDisplayLock);
+    return done;
+}
 
-static int ctxErrorHandler(Display *dpy, XErrorEvent * ev)
+static void ogliReleaseDisplayEGL(EGLDisplay dpy)
 {
-	ctxErrorOccurred = GL_TRUE;
-	return 0;
+    pthread_mutex_lock(&eglDisplayLock);
+    if (eglDisplayRefs && --eglDisplayRefs == 0)
+        eglTerminate(dpy);
+    pthread_mutex_unlock(&eglDisplayLock);
 }
 
-GLboolean ogliCreateContext(OGLI_CONTEXT * ctx)
+static GLboolean ogliCreateContextEGL(OGLI_CONTEXT * ctx)
 {
-    /* framebuffer desired config */
-    static int visual_attribs[] =
+    PFNEGLGETPLATFORMDISPLAYEXTPROC eglGetPlatformDisplayEXT;
+    const char  * eglExts;
+    EGLConfig   config = EGL_NO_CONFIG_KHR;
+    EGLint      egl_major, egl_minor, numConfigs, idx = 0;
+    EGLint      context_attribs[12];
+    static const EGLint config_attribs[] =
     {
-        GLX_X_RENDERABLE    , GL_TRUE,
-        GLX_DRAWABLE_TYPE   , GLX_WINDOW_BIT,
-        GLX_RENDER_TYPE     , GLX_RGBA_BIT,
-        GLX_X_VISUAL_TYPE   , GLX_TRUE_COLOR,
-        GLX_RED_SIZE        , 8,
-        GLX_GREEN_SIZE      , 8,
-        GLX_BLUE_SIZE       , 8,
-        GLX_ALPHA_SIZE      , 8,
-        GLX_DEPTH_SIZE      , 24,
-        GLX_STENCIL_SIZE    , 8,
-        GLX_DOUBLEBUFFER    , GL_TRUE,
-        None
+        EGL_SURFACE_TYPE    , 0,
+        EGL_RENDERABLE_TYPE , EGL_OPENGL_BIT,
+        EGL_NONE
     };
-    int glx_major, glx_minor;
 
-    if (!ctx)
-    { 
-        ogliLog("ogliCreateContext: Invalid OGLI context");
+    /* the surfaceless platform is a client extension, query it without a display */
+    OGLI_BEGIN(ctx, OGLI_PHASE_DISPLAY);
+    eglExts = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+    if (!eglExts || !checkExtension(eglExts, "EGL_MESA_platform_surfaceless"))
+    {
+        ogliLog("ogliCreateContext: EGL_MESA_platform_surfaceless is not supported");
         return GL_FALSE;
     }
 
-    ctx->display = XOpenDisplay(NULL);
-    if (!ctx->display)
+    eglGetPlatformDisplayEXT = (PFNEGLGETPLATFORMDISPLAYEXTPROC) eglGetProcAddress("eglGetPlatformDisplayEXT");
+    if (!eglGetPlatformDisplayEXT)
     {
-        ogliLog("ogliCreateContext: Failed to open X display\n");
+        ogliLog("ogliCreateContext: Failed to obtain eglGetPlatformDisplayEXT()");
         return GL_FALSE;
     }
- 
-    /* FBConfigs were added in GLX version 1.3. */
-    if (!glXQueryVersion(ctx->display, &glx_major, &glx_minor) || 
-       ((glx_major == 1) && (glx_minor < 3)) || (glx_major < 1))
+
+    ctx->eglDisplay = eglGetPlatformDisplayEXT(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, NULL);
+    if (ctx->eglDisplay == EGL_NO_DISPLAY || !ogliAcquireDisplayEGL(ctx->eglDisplay, &egl_major, &egl_minor))
     {
-        ogliLog("ogliCreateContext: Unsupported GLX version");
+        ogliLog("ogliCreateContext: Failed to initialize EGL display");
         return GL_FALSE;
     }
 
-    int fbcount;
-    GLXFBConfig* fbc = glXChooseFBConfig(ctx->display, DefaultScreen(ctx->display), visual_attribs, &fbcount);
-    if (!fbc)
+    eglExts = eglQueryString(ctx->eglDisplay, EGL_EXTENSIONS);
+    if (!eglExts || !checkExtension(eglExts, "EGL_KHR_surfaceless_context"))
     {
-        ogliLog("ogliCreateContext: Unable to obtain a framebuffer config");
+        ogliLog("ogliCreateContext: EGL_KHR_surfaceless_context is not supported");
+        ogliReleaseDisplayEGL(ctx->eglDisplay);
         return GL_FALSE;
     }
-  
-    int best_fbc = -1, worst_fbc = -1, best_num_samp = -1, worst_num_samp = 999;
-    int i;
-    for (i = 0; i < fbcount; ++i)
+
+    if (!eglBindAPI(EGL_OPENGL_API))
+    {
+        ogliLog("ogliCreateContext: Desktop OpenGL is not supported by EGL");
+        ogliReleaseDisplayEGL(ctx->eglDisplay);
+        return GL_FALSE;
+    }
+
+    OGLI_END(ctx, OGLI_PHASE_DISPLAY);
+
+    /* a config is only needed when the implementation cannot create config-less contexts */
+    OGLI_BEGIN(ctx, OGLI_PHASE_CONFIG);
+    if (!checkExtension(eglExts, "EGL_KHR_no_config_context"))
     {
-        XVisualInfo *vi = glXGetVisualFromFBConfig(ctx->display, fbc[i]);
-        if (vi)
+        if (!eglChooseConfig(ctx->eglDisplay, config_attribs, &config, 1, &numConfigs) || numConfigs < 1)
         {
-            int samp_buf, samples;
-            glXGetFBConfigAttrib(ctx->display, fbc[i], GLX_SAMPLE_BUFFERS, &samp_buf);
-            glXGetFBConfigAttrib(ctx->display, fbc[i], GLX_SAMPLES       , &samples );
-      
-            if (best_fbc < 0 || samp_buf && samples > best_num_samp)
-                best_fbc = i, best_num_samp = samples;
-            if (worst_fbc < 0 || !samp_buf || samples < worst_num_samp)
-                worst_fbc = i, worst_num_samp = samples;
+            ogliLog("ogliCreateContext: Unable to obtain an EGL config");
+            ogliReleaseDisplayEGL(ctx->eglDisplay);
+            return GL_FALSE;
         }
-        XFree(vi);
     }
-    GLXFBConfig bestFbc = fbc[best_fbc];
-    XFree(fbc);
+    OGLI_END(ctx, OGLI_PHASE_CONFIG);
 
-    XVisualInfo *vi = glXGetVisualFromFBConfig(ctx->display, bestFbc);
-    XSetWindowAttributes swa;
-    swa.colormap = ctx->cmap = XCreateColormap(ctx->display, RootWindow(ctx->display, vi->screen), vi->visual, AllocNone);
-    swa.background_pixmap = None;
-    swa.border_pixel      = 0;
-    swa.event_mask        = StructureNotifyMask;
+    OGLI_BEGIN(ctx, OGLI_PHASE_CONTEXT);
+    if (ctx->profile != OGLI_LEGACY)
+    {
+        if (egl_major == 1 && egl_minor < 5 && !checkExtension(eglExts, "EGL_KHR_create_context"))
+        {
+            ogliLog("ogliCreateContext: EGL_KHR_create_context is not supported");
+            ogliReleaseDisplayEGL(ctx->eglDisplay);
+            return GL_FALSE;
+        }
+        context_attribs[idx++] = EGL_CONTEXT_MAJOR_VERSION_KHR;     /* request OpenGL 3.2 */
+        context_attribs[idx++] = 3;
+        context_attribs[idx++] = EGL_CONTEXT_MINOR_VERSION_KHR;
+        context_attribs[idx++] = 2;
+        context_attribs[idx++] = EGL_CONTEXT_OPENGL_PROFILE_MASK_KHR;
+        context_attribs[idx++] = ctx->profile == OGLI_COMPAT ? EGL_CONTEXT_OPENGL_COMPATIBILITY_PROFILE_BIT_KHR :
+                                                               EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT_KHR;
+        if (ctx->profile == OGLI_FORWARD)
+        {
+            context_attribs[idx++] = EGL_CONTEXT_FLAGS_KHR;
+            context_attribs[idx++] = EGL_CONTEXT_OPENGL_FORWARD_COMPATIBLE_BIT_KHR;
+        }
+    }
+    context_attribs[idx] = EGL_NONE;
 
-    ctx->win = XCreateWindow( ctx->display, RootWindow( ctx->display, vi->screen ), 
-                              0, 0, 10, 10, 0, vi->depth, InputOutput, 
-                              vi->visual, CWBorderPixel|CWColormap|CWEventMask, &swa );
-    if (!ctx->win)
+    ctx->eglConfig = config;
+    ctx->eglContext = eglCreateContext(ctx->eglDisplay, config, EGL_NO_CONTEXT, context_attribs);
+    if (ctx->eglContext == EGL_NO_CONTEXT)
     {
-        ogliLog("ogliCreateContext: Error creating window");
+        ogliLog("ogliCreateContext: Unable to create OpenGL context");
+        ogliReleaseDisplayEGL(ctx->eglDisplay);
         return GL_FALSE;
     }
-    XFree(vi);
-    XMapWindow(ctx->display, ctx->win);
+    OGLI_END(ctx, OGLI_PHASE_CONTEXT);
 
-    /* Get the default screen's GLX extension list */
-    const GLubyte *glxExts = (const GLubyte *) glXQueryExtensionsString(ctx->display, DefaultScreen(ctx->display));
+    OGLI_BEGIN(ctx, OGLI_PHASE_CURRENT);
+    if (!eglMakeCurrent(ctx->eglDisplay, EGL_NO_SURFACE, EGL_NO_SURFACE, ctx->eglContext))
+    {
+        ogliLog("ogliCreateContext: Error making context current");
+        eglDestroyContext(ctx->eglDisplay, ctx->eglContext);
+        ogliReleaseDisplayEGL(ctx->eglDisplay);
+        return GL_FALSE;
+    }
+    OGLI_END(ctx, OGLI_PHASE_CURRENT);
 
-    glXCreateContextAttribsARBProc glXCreateContextAttribsARB = (glXCreateContextAttribsARBProc)
-    glXGetProcAddressARB((const GLubyte *) "glXCreateContextAttribsARB");
-    ctx->context = 0;
-    ctxErrorOccurred = GL_FALSE;
-    int (*oldHandler)(Display*, XErrorEvent*) = XSetErrorHandler(&ctxErrorHandler);
+    ctx->active = GL_TRUE;
+    ctx->queried = 0;
+    if (ctx->profile != OGLI_LEGACY)
+    {
+        if (!ogliInitCore(ctx))
+            return GL_FALSE;
+    }
+
+    return GL_TRUE;
+}
+
+static GLboolean ogliProbeVersionEGL(OGLI_CONTEXT * ctx, OGLI_PROFILE profile, int major, int minor)
+{
+    EGLContext probe;
+    EGLint context_attribs[] =
+    {
+        EGL_CONTEXT_MAJOR_VERSION_KHR       , major,
+        EGL_CONTEXT_MINOR_VERSION_KHR       , minor,
+        EGL_CONTEXT_OPENGL_PROFILE_MASK_KHR , profile == OGLI_COMPAT ? EGL_CONTEXT_OPENGL_COMPATIBILITY_PROFILE_BIT_KHR :
+                                                                       EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT_KHR,
+        EGL_NONE
+    };
+
+    probe = eglCreateContext(ctx->eglDisplay, ctx->eglConfig, EGL_NO_CONTEXT, context_attribs);
+    if (probe == EGL_NO_CONTEXT)
+        return GL_FALSE;
+
+    eglDestroyContext(ctx->eglDisplay, probe);
+    return GL_TRUE;
+}
+
+static const OGLI_FBCONFIG_ATTRIB ogliFBConfigAttribsEGL[] =
+{
+    {EGL_CONFIG_ID                  , offsetof(OGLI_FBCONFIG, id)},
+    {EGL_NATIVE_VISUAL_ID           , offsetof(OGLI_FBCONFIG, visualId)},
+    {EGL_RED_SIZE                   , offsetof(OGLI_FBCONFIG, red)},
+    {EGL_GREEN_SIZE                 , offsetof(OGLI_FBCONFIG, green)},
+    {EGL_BLUE_SIZE                  , offsetof(OGLI_FBCONFIG, blue)},
+    {EGL_ALPHA_SIZE                 , offsetof(OGLI_FBCONFIG, alpha)},
+    {EGL_DEPTH_SIZE                 , offsetof(OGLI_FBCONFIG, depth)},
+    {EGL_STENCIL_SIZE               , offsetof(OGLI_FBCONFIG, stencil)},
+    {EGL_SAMPLES                    , offsetof(OGLI_FBCONFIG, samples)},
+    {EGL_SURFACE_TYPE               , offsetof(OGLI_FBCONFIG, drawables)},
+    {EGL_CONFIG_CAVEAT              , offsetof(OGLI_FBCONFIG, caveat)}
+};
+
+/* EGL configs have no stereo nor double buffering attributes, window surfaces are always 
+   back buffered and sRGB is chosen per surface */
+static GLboolean ogliQueryFBConfigsEGL(OGLI_CONTEXT * ctx)
+{
+    const OGLI_FBCONFIG_ATTRIB * attrib;
+    OGLI_FBCONFIG   * config;
+    EGLConfig       * configs;
+    EGLint          count = 0, idx, value, surfaces;
+    size_t          field;
+
+    if (!eglGetConfigs(ctx->eglDisplay, NULL, 0, &count) || count < 0)
+        count = 0;
+
+    configs = (EGLConfig *) malloc((count ? count : 1) * sizeof(EGLConfig));
+    if (!configs || !ogliAllocFBConfigs(ctx, count) || 
+        !eglGetConfigs(ctx->eglDisplay, configs, count, &count))
+    {
+        free(configs);
+        return GL_FALSE;
+    }
 
-    if (ctx->profile == OGLI_CORE)
+    for (idx = 0; idx < count; idx++)
     {
-        if (!checkExtension((char *) glxExts, "GLX_ARB_create_context") ||
-            !glXCreateContextAttribsARB)
+        config = &ctx->fbconfigs[idx];
+        for (field = 0; field < sizeof(ogliFBConfigAttribsEGL) / sizeof(ogliFBConfigAttribsEGL[0]); field++)
         {
-            ogliLog("ogliCreateContext: GLX_ARB_create_context is not supported");
-            return GL_FALSE;
+            attrib = &ogliFBConfigAttribsEGL[field];
+            value = 0;
+            eglGetConfigAttrib(ctx->eglDisplay, configs[idx], attrib->attrib, &value);
+            *OGLI_FBCONFIG_FIELD(config, attrib) = value;
         }
 
-        int context_attribs[] =
-        {
-            GLX_CONTEXT_MAJOR_VERSION_ARB, 3,	/* request OpenGL 3.2 */
-            GLX_CONTEXT_MINOR_VERSION_ARB, 2,
-            None
-        };
-        ctx->context = glXCreateContextAttribsARB(ctx->display, bestFbc, 0, GL_TRUE, context_attribs);
+        surfaces = config->drawables;
+        config->drawables = (surfaces & EGL_WINDOW_BIT  ? OGLI_FBCONFIG_WINDOW  : 0) |
+                            (surfaces & EGL_PIXMAP_BIT  ? OGLI_FBCONFIG_PIXMAP  : 0) |
+                            (surfaces & EGL_PBUFFER_BIT ? OGLI_FBCONFIG_PBUFFER : 0);
+        config->doubleBuffer = (surfaces & EGL_WINDOW_BIT) != 0;
+        config->caveat = config->caveat == EGL_SLOW_CONFIG ? OGLI_CAVEAT_SLOW :
+                         config->caveat == EGL_NON_CONFORMANT_CONFIG ? OGLI_CAVEAT_NON_CONFORMANT : OGLI_CAVEAT_NONE;
     }
-    else
+
+    free(configs);
+    ctx->totalFBConfigs = count;
+    return GL_TRUE;
+}
+
+static GLboolean ogliDestroyContextEGL(OGLI_CONTEXT * ctx)
+{
+    if (!ctx->pool || eglGetCurrentContext() == ctx->eglContext)
+        eglMakeCurrent(ctx->eglDisplay, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+    eglDestroyContext(ctx->eglDisplay, ctx->eglContext);
+    ogliReleaseDisplayEGL(ctx->eglDisplay);
+    if (!ctx->pool)
+        eglReleaseThread();     /* would also release the context of the pool current on the thread */
+
+    ctx->eglContext = EGL_NO_CONTEXT;
+    ctx->eglDisplay = EGL_NO_DISPLAY;
+    ctx->active = GL_FALSE;
+
+    return GL_TRUE;
+}
+
+#endif /* OGLI_USE_EGL */
+
+/* the first context of a profile hands its display, config and drawable over to the pool, 
+   on EGL the pool keeps a reference so that the display is never terminated in between */
+static void ogliPoolAdopt(OGLI_POOL * pool, OGLI_CONTEXT * ctx)
+{
+#ifdef OGLI_USE_EGL
+    EGLint major, minor;
+
+    if (ctx->backend == OGLI_BACKEND_EGL)
     {
-        ctx->context = glXCreateNewContext(ctx->display, bestFbc, GLX_RGBA_TYPE, 0, GL_TRUE);
+        if (pool->eglDisplay == EGL_NO_DISPLAY && ogliAcquireDisplayEGL(ctx->eglDisplay, &major, &minor))
+            pool->eglDisplay = ctx->eglDisplay;
+        return;
     }
-    XSync(ctx->display, GL_FALSE);
-    XSetErrorHandler(oldHandler);
+#endif /* OGLI_USE_EGL */
 
-    if (ctxErrorOccurred || !ctx->context)
+    if (!pool->display)
+        pool->display = ctx->display;
+    if (!pool->adopted[ctx->profile])
     {
-        ogliLog("ogliCreateContext: Unable to create OpenGL context");
-        return GL_FALSE;
+        pool->fbconfig[ctx->profile] = ctx->fbconfig;
+        pool->drawable[ctx->profile] = ctx->drawable;
+        pool->win[ctx->profile] = ctx->win;
+        pool->cmap[ctx->profile] = ctx->cmap;
+        pool->pbuffer[ctx->profile] = ctx->pbuffer;
+        pool->adopted[ctx->profile] = GL_TRUE;
     }
+}
 
-    glXMakeCurrent(ctx->display, ctx->win, ctx->context);
+/* every context of the pool is destroyed by now */
+static void ogliPoolClose(OGLI_POOL * pool)
+{
+    GLuint profile;
 
-    ctx->active = GL_TRUE;
-    if (ctx->profile == OGLI_CORE)
+#ifdef OGLI_USE_EGL
+    if (pool->eglDisplay != EGL_NO_DISPLAY)
     {
-        if (!ogliInitCore())
-            return GL_FALSE;
+        ogliReleaseDisplayEGL(pool->eglDisplay);
+        eglReleaseThread();
     }
+#endif /* OGLI_USE_EGL */
 
-    return GL_TRUE;
+    if (!pool->display)
+        return;
+    for (profile = 0; profile < OGLI_TOTAL_PROFILES; profile++)
+    {
+        if (pool->pbuffer[profile])
+            glXDestroyPbuffer(pool->display, pool->pbuffer[profile]);
+        if (pool->win[profile])
+        {
+            XDestroyWindow(pool->display, pool->win[profile]);
+            XFreeColormap(pool->display, pool->cmap[profile]);
+        }
+    }
+    XCloseDisplay(pool->display);
+}
+
+GLboolean ogliCreateContext(OGLI_CONTEXT * ctx)
+{
+    if (!ctx)
+    { 
+        ogliLog("ogliCreateContext: Invalid OGLI context");
+        return GL_FALSE;
+    }
+
+#ifdef OGLI_USE_EGL
+    if (ctx->backend == OGLI_BACKEND_EGL)
+        return ogliCreateContextEGL(ctx);
+#endif /* OGLI_USE_EGL */
+
+    return ogliCreateContextGLX(ctx);
 }
 
 GLboolean ogliDestroyContext(OGLI_CONTEXT * ctx)
 {
+    GLboolean done;
+
     if (!ctx)
     {
         ogliLog("ogliDestroyContext: Invalid OGLI context");
         return GL_FALSE;
     }
 
-    glXMakeCurrent(ctx->display, 0, 0);
-    glXDestroyContext(ctx->display, ctx->context);
+    OGLI_BEGIN(ctx, OGLI_PHASE_DESTROY);
+#ifdef OGLI_USE_EGL
+    if (ctx->backend == OGLI_BACKEND_EGL)
+        done = ogliDestroyContextEGL(ctx);
+    else
+#endif /* OGLI_USE_EGL */
+        done = ogliDestroyContextGLX(ctx);
+    OGLI_END(ctx, OGLI_PHASE_DESTROY);
+
+    return done;
+}
 
-    XDestroyWindow(ctx->display, ctx->win);
-    XFreeColormap(ctx->display, ctx->cmap);
-    XCloseDisplay(ctx->display);
+const OGLI_FBCONFIG * ogliQueryFBConfigs(OGLI_CONTEXT * ctx, GLuint * count)
+{
+    GLboolean done;
 
-    ctx->active = GL_FALSE;
+    if (count)
+        *count = 0;
 
-    return GL_TRUE;
+    if (!ctx || !ctx->active)
+    {
+        ogliLog("ogliQueryFBConfigs: OGLI is not ready");
+        return NULL;
+    }
+
+#ifdef OGLI_USE_EGL
+    if (ctx->backend == OGLI_BACKEND_EGL)
+        done = ogliQueryFBConfigsEGL(ctx);
+    else
+#endif /* OGLI_USE_EGL */
+        done = ogliQueryFBConfigsGLX(ctx);
+
+    if (!done)
+        return NULL;
+    if (count)
+        *count = ctx->totalFBConfigs;
+    return ctx->fbconfigs;
 }
 
-#endif
+static GLboolean ogliProbeVersion(OGLI_CONTEXT * ctx, OGLI_PROFILE profile, int major, int minor)
+{
+#ifdef OGLI_USE_EGL
+    if (ctx->backend == OGLI_BACKEND_EGL)
+        return ogliProbeVersionEGL(ctx, profile, major, minor);
+#endif /* OGLI_USE_EGL */
+
+    return ogliProbeVersionGLX(ctx, profile, major, minor);
+}
+
+#endif
\ No newline at end of file
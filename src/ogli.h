@@ -37,6 +37,9 @@ extern "C" {
 /* to make use of the GLEW library, enable the line below */
 /* #define OGLI_USE_GLEW 1 */   /* mark for GLEW removal */
 
+/* to allow headless context creation through EGL on Linux, enable the line below */
+/* #define OGLI_USE_EGL  1 */
+
 /* for debugging purpose, enable the line below */
 /* #define OGLI_DEBUG    1 */
 
@@ -69,6 +72,10 @@ extern "C" {
 #       include <GL/glx.h>
 #       include <GL/gl.h>
 #       include <GL/glu.h>  /* to install, type 'sudo apt install libgl1-mesa-dev libglu1-mesa-dev' in Terminal */
+#   ifdef  OGLI_USE_EGL
+#       include <EGL/egl.h>  /* to install, type 'sudo apt install libegl1-mesa-dev' in Terminal */
+#       include <EGL/eglext.h>
+#   endif
 #   endif
 #endif
 
@@ -82,10 +89,22 @@ extern "C" {
 #	pragma warning (disable:4996)	    /* enable preprocessor _CRT_SECURE_NO_WARNINGS */
 #endif
 
+/* functions of the library API, the only symbols libogli exports */
+#ifndef OGLI_API
+#   if defined(__GNUC__) && !defined(_WIN32)
+#       define OGLI_API __attribute__((visibility("default")))
+#   else
+#       define OGLI_API
+#   endif
+#endif
+
 #define OGLI_MAX_INFO_LENGTH (128)	    /* maximum length of an information string */
-#define OGLI_MAX_EXT_LENGTH  (10240)	/* maximum length of an extension string */
-#define OGLI_MAJOR_VERSION  1           /* library version number */
-#define OGLI_MINOR_VERSION  1
+#define OGLI_MAX_LIMITS      (64)       /* maximum number of implementation limits */
+#define OGLI_MAX_LIMIT_VALUES (3)       /* maximum number of values of a limit */
+#define OGLI_MAX_FORMATS     (96)       /* maximum number of internal format and target pairs */
+#define OGLI_TIMER_RING      (8)        /* measurements a timer keeps in flight */
+#define OGLI_MAJOR_VERSION  4           /* library version number */
+#define OGLI_MINOR_VERSION  3
 
 /* library platform */
 #ifdef  _WIN32
@@ -100,8 +119,27 @@ extern "C" {
 #   define  OGLI_PLATFORM    ("OGLI-LINUX")
 #endif
 
-/* OpenGL profile for querying information */
-typedef enum {OGLI_LEGACY, OGLI_CORE} OGLI_PROFILE;
+/* OpenGL profile for querying information, compatibility and forward-compatible profiles 
+   are requested as OpenGL 3.2 contexts */
+typedef enum {OGLI_LEGACY, OGLI_CORE, OGLI_COMPAT, OGLI_FORWARD} OGLI_PROFILE;
+
+#define OGLI_TOTAL_PROFILES  4
+
+#ifndef APIENTRY
+#   define APIENTRY
+#endif
+
+/* backend used to create the rendering context */
+typedef enum {OGLI_BACKEND_NATIVE, OGLI_BACKEND_EGL} OGLI_BACKEND;
+
+/* drawable the GLX context was made current on */
+typedef enum {OGLI_DRAWABLE_WINDOW, OGLI_DRAWABLE_PBUFFER, OGLI_DRAWABLE_NONE} OGLI_DRAWABLE;
+
+/* 64-bit integers for platforms with no OpenGL 3.2 headers */
+#if !defined(GL_VERSION_3_2) && !defined(__gl3_h_)
+typedef long long GLint64;
+typedef unsigned long long GLuint64;
+#endif
 
 /* OpenGL version block */
 typedef struct gl_version_block
@@ -118,6 +156,60 @@ typedef struct glsl_version_block
     GLint minor;
 } OGLI_GLSL_VERSION_BLOCK;
 
+/* Extension list, the offsets table and the names share one allocation sized from what 
+   the driver reports. Names are kept space separated and zero-terminated so that 'names' 
+   is still usable as a legacy extension string. */
+typedef struct ext_list
+{
+    char    * names;            /* space separated names */
+    GLuint  * offsets;          /* start of each name, offsets[count] is one past the end */
+    GLuint  count;              /* number of names */
+    GLuint  size;               /* bytes used by names, including the terminator */
+} OGLI_EXT_LIST;
+
+/* Implementation limit, the limits table of the library gives the name of each entry */
+typedef struct gl_limit
+{
+    GLint64 values[OGLI_MAX_LIMIT_VALUES];
+    GLuint  count;              /* number of values, 0 when the limit is not available */
+} OGLI_LIMIT;
+
+/* Capabilities of an internal format on a target, the formats table of the library names both */
+#define OGLI_FORMAT_SUPPORTED           0x0001
+#define OGLI_FORMAT_COLOR_RENDERABLE    0x0002
+#define OGLI_FORMAT_DEPTH_RENDERABLE    0x0004  /* depth or depth-stencil attachment */
+typedef struct gl_format
+{
+    GLuint  flags;              /* OGLI_FORMAT_*, 0 when the format cannot be used on the target */
+    GLenum  format;             /* GL_TEXTURE_IMAGE_FORMAT, upload format the driver does not convert */
+    GLenum  type;               /* GL_TEXTURE_IMAGE_TYPE */
+    GLint   maxSamples;         /* highest sample count, 0 on single sample targets */
+} OGLI_FORMAT;
+
+/* where the format capabilities come from, the specification requirements are the last resort */
+typedef enum {OGLI_FORMATS_NONE, OGLI_FORMATS_SPEC, OGLI_FORMATS_QUERY, OGLI_FORMATS_QUERY2} OGLI_FORMAT_SOURCE;
+
+/* parts of the information block fetched by ogliQueryEx() */
+#define OGLI_Q_BASIC        0x0001      /* vendor, renderer, version, GLSL and extension count */
+#define OGLI_Q_EXTENSIONS   0x0002      /* extension list and its index, implies OGLI_Q_BASIC */
+#define OGLI_Q_LIMITS       0x0004      /* implementation limits, implies OGLI_Q_EXTENSIONS */
+#define OGLI_Q_GLU          0x0008      /* GLU version and extensions */
+#define OGLI_Q_ALL          0x000F
+
+/* where the renderer identity comes from, GLX_MESA_query_renderer needs no context */
+typedef enum {OGLI_RENDERER_NONE, OGLI_RENDERER_DISPLAY, OGLI_RENDERER_CONTEXT} OGLI_RENDERER_SOURCE;
+
+/* Renderer identity, the fields are only meaningful when the source is not OGLI_RENDERER_NONE */
+typedef struct gl_renderer
+{
+    GLuint      vendorId;       /* PCI vendor ID, 0 when the renderer is not a PCI device */
+    GLuint      deviceId;       /* PCI device ID */
+    GLuint      videoMemory;    /* video memory in MB */
+    GLboolean   accelerated;    /* GL_FALSE for software rendering */
+    GLboolean   unifiedMemory;  /* the GPU shares the system memory */
+    OGLI_RENDERER_SOURCE source;
+} OGLI_RENDERER;
+
 /* OpenGL information block */
 typedef struct gl_info_block
 {
@@ -125,20 +217,156 @@ typedef struct gl_info_block
     char    glRenderer[OGLI_MAX_INFO_LENGTH];
     char    glVersion[OGLI_MAX_INFO_LENGTH];
     char    glSL[OGLI_MAX_INFO_LENGTH];
-    char    glExtensions[OGLI_MAX_EXT_LENGTH];
+    OGLI_EXT_LIST   glExtensions;
     char    gluVersion[OGLI_MAX_INFO_LENGTH];
-    char    gluExtensions[OGLI_MAX_EXT_LENGTH];
+    OGLI_EXT_LIST   gluExtensions;
     GLuint  totalExtensions;
     OGLI_GL_VERSION_BLOCK    versionGL;
     OGLI_GLSL_VERSION_BLOCK  versionGLSL;
+    OGLI_GL_VERSION_BLOCK    maxCore;   /* highest core context version, set by ogliDiscoverVersions() or ogliQueryRenderer() */
+    OGLI_GL_VERSION_BLOCK    maxCompat; /* highest compatibility context version, zero if none */
+    OGLI_LIMIT  limits[OGLI_MAX_LIMITS];    /* in the order of the limits table */
+    GLuint  totalLimits;                    /* number of available limits */
+    OGLI_FORMAT formats[OGLI_MAX_FORMATS];  /* set by ogliQueryFormats(), in the order of the formats table */
+    GLuint  totalFormats;                   /* number of supported pairs */
+    OGLI_FORMAT_SOURCE formatSource;
+    OGLI_RENDERER renderer;                 /* set by ogliQueryRenderer() */
 } GL_INFO_BLOCK;
 
+/* Drawables and caveats of a framebuffer config */
+#define OGLI_FBCONFIG_WINDOW        0x0001
+#define OGLI_FBCONFIG_PIXMAP        0x0002
+#define OGLI_FBCONFIG_PBUFFER       0x0004
+typedef enum {OGLI_CAVEAT_NONE, OGLI_CAVEAT_SLOW, OGLI_CAVEAT_NON_CONFORMANT} OGLI_CAVEAT;
+
+/* Framebuffer config of the display (GLX FBConfig or EGL config) */
+typedef struct gl_fbconfig
+{
+    GLint   id;                 /* config identifier of the window system */
+    GLint   visualId;           /* native visual, 0 when there is none */
+    GLint   red, green, blue, alpha;
+    GLint   depth, stencil;
+    GLint   samples;            /* 0 without multisampling */
+    GLint   doubleBuffer;
+    GLint   stereo;
+    GLint   sRGB;               /* sRGB capable */
+    GLint   drawables;          /* OGLI_FBCONFIG_WINDOW | PIXMAP | PBUFFER */
+    GLint   caveat;             /* OGLI_CAVEAT */
+} OGLI_FBCONFIG;
+
+/* Pipeline phases measured when timings are enabled, in pipeline order */
+typedef enum
+{
+    OGLI_PHASE_DISPLAY,         /* display connection, window class and window */
+    OGLI_PHASE_CONFIG,          /* framebuffer config or pixel format selection */
+    OGLI_PHASE_CONTEXT,         /* rendering context creation */
+    OGLI_PHASE_CURRENT,         /* drawable creation and making the context current */
+    OGLI_PHASE_INIT_CORE,       /* core profile entry points */
+    OGLI_PHASE_QUERY,           /* strings, extensions and their index */
+    OGLI_PHASE_LIMITS,          /* implementation limits */
+    OGLI_PHASE_GLU,             /* OpenGL Utility Library strings */
+    OGLI_PHASE_DESTROY,         /* context and drawable destruction */
+    OGLI_PHASE_CACHE,           /* capability cache load and store */
+    OGLI_TOTAL_PHASES
+} OGLI_PHASE;
+
+/* Duration of a pipeline phase, times are in seconds since ogliSetTimings() */
+typedef struct gl_timing
+{
+    double  start;              /* first entry into the phase */
+    double  duration;           /* total time spent in the phase */
+    GLuint  count;              /* number of completed entries, 0 when never reached */
+} OGLI_TIMING;
+
+/* Entry point of the OpenGL implementation, cast to the actual function type before use */
+typedef void (APIENTRY * OGLI_PROC)(void);
+
+/* Extension lists exposed through the iterator API */
+typedef enum {OGLI_EXT_GL, OGLI_EXT_GLU} OGLI_EXT_SOURCE;
+
+/* Extension visitor, 'name' is not zero-terminated, return GL_FALSE to stop iterating */
+typedef GLboolean (*OGLI_EXT_CALLBACK)(const char * name, GLuint length, void * user);
+
+/* Extension index entry, refers to a name inside the extension string */
+typedef struct ext_index_slot
+{
+    const char  * name;         /* NULL for an empty slot */
+    GLuint      length;         /* name length, names are not zero-terminated */
+    GLuint      hash;           /* cached hash of the name */
+} OGLI_EXT_INDEX_SLOT;
+
+/* Open addressing hash set of extension names, built once by ogliQuery() */
+typedef struct ext_index
+{
+    OGLI_EXT_INDEX_SLOT * slots;
+    GLuint      capacity;       /* always a power of two */
+    GLuint      count;          /* number of distinct names */
+} OGLI_EXT_INDEX;
+
+/* how a timer measures: GL_TIMESTAMP pairs, GL_TIME_ELAPSED when timestamps have no counter 
+   bits, or the CPU clock when submitting without GL_ARB_timer_query */
+typedef enum {OGLI_TIMER_CPU, OGLI_TIMER_TIMESTAMP, OGLI_TIMER_ELAPSED} OGLI_TIMER_MODE;
+
+/* entry points of timer queries */
+typedef void (APIENTRY * OGLI_GENQUERIES_PROC)(GLsizei n, GLuint * ids);
+typedef void (APIENTRY * OGLI_DELETEQUERIES_PROC)(GLsizei n, const GLuint * ids);
+typedef void (APIENTRY * OGLI_BEGINQUERY_PROC)(GLenum target, GLuint id);
+typedef void (APIENTRY * OGLI_ENDQUERY_PROC)(GLenum target);
+typedef void (APIENTRY * OGLI_QUERYCOUNTER_PROC)(GLuint id, GLenum target);
+typedef void (APIENTRY * OGLI_GETQUERYIV_PROC)(GLenum target, GLenum pname, GLint * value);
+typedef void (APIENTRY * OGLI_GETQUERYOBJECTIV_PROC)(GLuint id, GLenum pname, GLint * value);
+typedef void (APIENTRY * OGLI_GETQUERYOBJECTUI64_PROC)(GLuint id, GLenum pname, GLuint64 * value);
+typedef void (APIENTRY * OGLI_GETINTEGER64_PROC)(GLenum pname, GLint64 * value);
+
+/* Timer of GL work, results are read back a few frames later instead of waiting for the GPU */
+typedef struct gl_timer
+{
+    OGLI_TIMER_MODE mode;       /* OGLI_TIMER_CPU when the GPU cannot be timed */
+    double          resolution; /* smallest clock step in seconds, 0 until ogliTimerCalibrate() */
+    double          offset;     /* ogliNow() minus the GPU clock in seconds, set by ogliTimerCalibrate() */
+    GLuint          queries[OGLI_TIMER_RING * 2];   /* begin and end of each slot */
+    double          submitted[OGLI_TIMER_RING * 2]; /* ogliNow() at begin and end of each slot */
+    GLuint          issued;     /* measurements ended */
+    GLuint          read;       /* measurements read back */
+    GLboolean       running;    /* between ogliTimerBegin() and ogliTimerEnd() */
+
+/*--- entry points of the context the timer was created on ---*/
+    OGLI_GENQUERIES_PROC            genQueries;
+    OGLI_DELETEQUERIES_PROC         deleteQueries;
+    OGLI_BEGINQUERY_PROC            beginQuery;
+    OGLI_ENDQUERY_PROC              endQuery;
+    OGLI_QUERYCOUNTER_PROC          queryCounter;
+    OGLI_GETQUERYIV_PROC            getQueryiv;
+    OGLI_GETQUERYOBJECTIV_PROC      getQueryObjectiv;
+    OGLI_GETQUERYOBJECTUI64_PROC    getQueryObjectui64v;
+    OGLI_GETINTEGER64_PROC          getInteger64v;
+} OGLI_TIMER;
+
+struct gl_info_pool;
+
 /* Context for OpenGL information query */
 typedef struct gl_info_context
 {
     OGLI_PROFILE    profile;    /* query legacy or core profile */
+    OGLI_BACKEND    backend;    /* native (WGL/CGL/GLX) or EGL backend */
     GL_INFO_BLOCK   iblock;     /* OpenGL information block */
+    OGLI_EXT_INDEX  extIndex;   /* fast lookup of the OpenGL extensions */
     GLboolean       active;     /* ready for information query flag */
+    GLboolean       windowless; /* avoid mapping a window when possible */
+    GLboolean       timed;      /* measure the pipeline phases */
+    double          timeBase;   /* ogliNow() when timings were enabled */
+    double          phaseEntry[OGLI_TOTAL_PHASES];  /* entry time of the phases in progress */
+    OGLI_TIMING     timings[OGLI_TOTAL_PHASES];
+    OGLI_FBCONFIG   * fbconfigs;        /* filled by ogliQueryFBConfigs() */
+    GLuint          totalFBConfigs;
+
+/*--- entry points, owned by the context so that contexts can live on different threads ---*/
+    const GLubyte * (APIENTRY * getStringi)(GLenum name, GLuint index);
+#ifdef _WIN32
+    HGLRC           (WINAPI * createContextAttribs)(HDC dc, HGLRC share, const int * attribs);
+#elif !defined(__APPLE__)
+    GLXContext      (* createContextAttribs)(Display * dpy, GLXFBConfig config, GLXContext share, Bool direct, const int * attribs);
+#endif
 
 /*--- platform specific attributes ---*/
 #ifdef _WIN32
@@ -153,9 +381,55 @@ typedef struct gl_info_context
     Display         *display;   /* X display */
     Colormap        cmap;       /* color map */
     Window          win;        /* X Window */
+    GLXPbuffer      pbuffer;    /* offscreen drawable in windowless mode */
+    GLXFBConfig     fbconfig;   /* framebuffer config of the context */
+    char            displayName[OGLI_MAX_INFO_LENGTH];  /* X display to open, empty for $DISPLAY */
+    GLint           screen;     /* screen of the display, -1 for its default screen */
+    OGLI_DRAWABLE   drawable;   /* drawable the context is current on */
+    GLboolean       errorOccurred;  /* an X error was trapped on the display */
+    struct gl_info_context * nextTrap;  /* contexts trapping X errors */
+#   ifdef OGLI_USE_EGL
+    EGLDisplay      eglDisplay; /* EGL surfaceless display */
+    EGLContext      eglContext; /* EGL rendering context */
+    EGLConfig       eglConfig;  /* EGL_NO_CONFIG_KHR when config-less */
+#   endif
 #endif
+
+/*--- appended so that the fields above keep their place ---*/
+    GLuint          queried;    /* OGLI_Q_* parts of the information block already fetched */
+    struct gl_info_pool * pool; /* pool owning the display and drawable, NULL when standalone */
 } OGLI_CONTEXT;
 
+#define OGLI_POOL_IDLE  4           /* idle contexts kept per profile */
+
+/* Contexts handed out again and again, on Linux they share one display and, per profile, one 
+   framebuffer config and drawable taken over from the first context created */
+typedef struct gl_info_pool
+{
+    OGLI_BACKEND    backend;
+    GLboolean       windowless;
+    OGLI_CONTEXT    * idle[OGLI_TOTAL_PROFILES][OGLI_POOL_IDLE];
+    GLuint          idleCount[OGLI_TOTAL_PROFILES];
+    GLuint          created;    /* contexts created by ogliPoolAcquire() */
+    GLuint          reused;     /* idle contexts handed out again */
+#ifdef __linux__
+    Display         * display;  /* X display of the native backend */
+    GLboolean       adopted[OGLI_TOTAL_PROFILES];   /* config and drawable below are set */
+    GLXFBConfig     fbconfig[OGLI_TOTAL_PROFILES];
+    OGLI_DRAWABLE   drawable[OGLI_TOTAL_PROFILES];
+    Window          win[OGLI_TOTAL_PROFILES];
+    Colormap        cmap[OGLI_TOTAL_PROFILES];
+    GLXPbuffer      pbuffer[OGLI_TOTAL_PROFILES];
+#   ifdef OGLI_USE_EGL
+    EGLDisplay      eglDisplay; /* the pool holds one reference on it */
+    EGLConfig       eglConfig;
+#   endif
+#endif
+
+/*--- appended so that the fields above keep their place ---*/
+    GLuint          outstanding;    /* contexts acquired and not released yet */
+} OGLI_POOL;
+
 /*
  * OpenGL information query pipeline:
  *   ogliInit() -> ogliCreateContext() -> ogliQuery() -+-> ogliSupported() -+ 
@@ -163,15 +437,107 @@ typedef struct gl_info_context
  *                                                     +--------------------+
  *                                                                          |
  *                                 ogliShutdown() <- ogliDestroyContext() <-+
+ *
+ * Every context is self contained, entry points and X error trapping included: distinct 
+ * contexts may go through the pipeline on different threads at the same time. On Linux, the
+ * first ogliInit() calls XInitThreads(), it must come before any other Xlib call of the process.
+ *
+ * ogliQuery() fetches the whole information block, ogliQueryEx() only the OGLI_Q_* parts of
+ * its mask that are not fetched yet. While the context is active, ogliGetInfo(), ogliSupported()
+ * and ogliSupportedMany() fetch the parts they need on first use. On Linux, libGLU is loaded
+ * the first time OGLI_Q_GLU is asked for.
+ *
+ * On Linux, ogliSetDisplay() selects the X display and screen of the native backend before
+ * ogliCreateContext(), ogliScreenCount() tells how many screens a display has.
+ *
+ * With ogliSetTimings(), each phase of the pipeline is timed with a monotonic clock and the
+ * breakdown is read back by ogliGetTimings(). Disabled timings cost a flag test per phase.
+ *
+ * ogliQueryRenderer() may stand in for ogliCreateContext() when only the renderer is needed:
+ * on Linux, GLX_MESA_query_renderer gives the vendor and renderer strings, the PCI IDs, the
+ * video memory and the highest core and compatibility versions with no context. On an active
+ * context, it fills the renderer fields the strings do not tell.
+ *
+ * ogliDiscoverVersions() may be called on an active context, after ogliQuery(), to search
+ * the highest core and compatibility versions the driver can create.
+ *
+ * ogliQueryFormats() may be called on an active context to fill the internal format
+ * capabilities through GL_ARB_internalformat_query2 when available.
+ *
+ * ogliTimerCreate() times GL work on an active context, current on the calling thread. A
+ * measurement goes from ogliTimerBegin() to ogliTimerEnd(), and ogliTimerRead() returns the
+ * oldest one once the GPU is done with it, never waiting. Up to OGLI_TIMER_RING measurements
+ * may be pending. ogliTimerDestroy() must be called before the context is destroyed.
+ *
+ * ogliPoolAcquire() hands out an active context of a profile, current on the calling thread:
+ * an idle one unless 'fresh' is set or none is left. On Linux, fresh contexts of a pool skip
+ * opening the display, choosing a config and creating a drawable. ogliPoolRelease() keeps up
+ * to OGLI_POOL_IDLE contexts per profile idle, their GL state and information block as left,
+ * and destroys the others. A pool and its contexts are used by one thread at a time, its
+ * contexts are destroyed by ogliPoolDestroy(), never by ogliShutdown(). Every context acquired
+ * must be released first, ogliPoolDestroy() fails and leaves the pool as is otherwise.
+ *
+ * ogliQueryFBConfigs() lists every framebuffer config of the display of an active context,
+ * the list is owned by the context and released by ogliShutdown().
+ *
+ * ogliCacheLoad() may stand in for ogliCreateContext() -> ogliQuery() -> ogliDestroyContext()
+ * when the results of an identical driver setup have been saved by ogliCacheStore().
+ *
+ * As libogli, contexts are only allocated by ogliInit() and the information block is read
+ * through the returned pointer. The soname follows OGLI_MAJOR_VERSION, which is raised when
+ * a function or a field visible here changes in an incompatible way. Within a major version,
+ * new fields are only appended at the end of the structures.
  */
 
-OGLI_CONTEXT * ogliInit(OGLI_PROFILE profile);
-GLboolean   ogliShutdown(OGLI_CONTEXT * ctx);
-GLboolean   ogliCreateContext(OGLI_CONTEXT * ctx);
-GLboolean   ogliDestroyContext(OGLI_CONTEXT * ctx);
-GLboolean   ogliSupported(OGLI_CONTEXT * ctx, const char * extension);
-GLboolean   ogliQuery(OGLI_CONTEXT * ctx);
-GLuint      ogliGetVersion();
+OGLI_API OGLI_CONTEXT * ogliInit(OGLI_PROFILE profile);
+OGLI_API GLboolean   ogliSetBackend(OGLI_CONTEXT * ctx, OGLI_BACKEND backend);
+OGLI_API GLboolean   ogliSetWindowless(OGLI_CONTEXT * ctx, GLboolean windowless);
+OGLI_API GLboolean   ogliSetDisplay(OGLI_CONTEXT * ctx, const char * display, GLint screen);
+OGLI_API GLint       ogliScreenCount(const char * display);
+OGLI_API GLboolean   ogliSetTimings(OGLI_CONTEXT * ctx, GLboolean enable);
+OGLI_API const OGLI_TIMING * ogliGetTimings(const OGLI_CONTEXT * ctx);
+OGLI_API const char* ogliPhaseName(OGLI_PHASE phase);
+OGLI_API double      ogliNow();
+OGLI_API GLboolean   ogliShutdown(OGLI_CONTEXT * ctx);
+OGLI_API GLboolean   ogliCreateContext(OGLI_CONTEXT * ctx);
+OGLI_API GLboolean   ogliDestroyContext(OGLI_CONTEXT * ctx);
+OGLI_API GLboolean   ogliSupported(OGLI_CONTEXT * ctx, const char * extension);
+OGLI_API GLuint      ogliSupportedMany(OGLI_CONTEXT * ctx, const char ** extensions, GLuint count, GLboolean * results);
+OGLI_API GLboolean   ogliQuery(OGLI_CONTEXT * ctx);
+OGLI_API GLboolean   ogliQueryEx(OGLI_CONTEXT * ctx, GLuint mask);
+OGLI_API const GL_INFO_BLOCK * ogliGetInfo(OGLI_CONTEXT * ctx, GLuint mask);
+OGLI_API GLboolean   ogliQueryRenderer(OGLI_CONTEXT * ctx);
+OGLI_API const char* ogliRendererSourceName(OGLI_RENDERER_SOURCE source);
+OGLI_API GLboolean   ogliDiscoverVersions(OGLI_CONTEXT * ctx);
+OGLI_API GLboolean   ogliQueryFormats(OGLI_CONTEXT * ctx);
+OGLI_API GLuint      ogliFormatCount();
+OGLI_API const char* ogliFormatName(GLuint index);
+OGLI_API const char* ogliFormatTarget(GLuint index);
+OGLI_API const char* ogliFormatSourceName(OGLI_FORMAT_SOURCE source);
+OGLI_API const char* ogliPixelName(GLenum value);
+OGLI_API const OGLI_FORMAT * ogliGetFormat(const OGLI_CONTEXT * ctx, const char * format, const char * target);
+OGLI_API OGLI_TIMER * ogliTimerCreate(OGLI_CONTEXT * ctx);
+OGLI_API GLboolean   ogliTimerCalibrate(OGLI_TIMER * timer);
+OGLI_API GLboolean   ogliTimerBegin(OGLI_TIMER * timer);
+OGLI_API GLboolean   ogliTimerEnd(OGLI_TIMER * timer);
+OGLI_API GLboolean   ogliTimerRead(OGLI_TIMER * timer, double * start, double * elapsed);
+OGLI_API GLboolean   ogliTimerDestroy(OGLI_TIMER * timer);
+OGLI_API OGLI_POOL *  ogliPoolCreate(OGLI_BACKEND backend, GLboolean windowless);
+OGLI_API OGLI_CONTEXT * ogliPoolAcquire(OGLI_POOL * pool, OGLI_PROFILE profile, GLboolean fresh);
+OGLI_API GLboolean   ogliPoolRelease(OGLI_POOL * pool, OGLI_CONTEXT * ctx);
+OGLI_API GLboolean   ogliPoolDestroy(OGLI_POOL * pool);
+OGLI_API const OGLI_FBCONFIG * ogliQueryFBConfigs(OGLI_CONTEXT * ctx, GLuint * count);
+OGLI_API GLuint      ogliExtensionCount(const OGLI_CONTEXT * ctx, OGLI_EXT_SOURCE source);
+OGLI_API const char* ogliExtensionAt(const OGLI_CONTEXT * ctx, OGLI_EXT_SOURCE source, GLuint index, GLuint * length);
+OGLI_API GLuint      ogliForEachExtension(const OGLI_CONTEXT * ctx, OGLI_EXT_SOURCE source, OGLI_EXT_CALLBACK callback, void * user);
+OGLI_API GLuint      ogliLimitCount();
+OGLI_API const char* ogliLimitName(GLuint index);
+OGLI_API const OGLI_LIMIT * ogliGetLimit(const OGLI_CONTEXT * ctx, const char * name);
+OGLI_API GLboolean   ogliCacheLoad(OGLI_CONTEXT * ctx, const char * dir);
+OGLI_API GLboolean   ogliCacheStore(OGLI_CONTEXT * ctx, const char * dir);
+OGLI_API OGLI_PROC   ogliGetProc(const OGLI_CONTEXT * ctx, const char * name);
+OGLI_API const char* ogliProfileName(OGLI_PROFILE profile);
+OGLI_API GLuint      ogliGetVersion();
 
 #ifdef __cplusplus
 }
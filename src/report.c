@@ -0,0 +1,1134 @@
+/* OpenGL Information Query Utility - Reports
+**
+** Copyrights (c) 2021-2023 by Trinh D.D. Nguyen <dzutrinh[]yahoo.com>
+** All Rights Reserved
+** 
+** Redistribution and use in source and binary forms, with or without 
+** modification, are permitted provided that the following conditions are met:
+** 
+** * Redistributions of source code must retain the above copyright notice, 
+**   this list of conditions and the following disclaimer.
+** * Redistributions in binary form must reproduce the above copyright notice, 
+**   this list of conditions and the following disclaimer in the documentation 
+**   and/or other materials provided with the distribution.
+** * The name of the author may be used to endorse or promote products 
+**   derived from this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE 
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF 
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+** THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <errno.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#ifdef _WIN32
+#   include <io.h>
+#   define write   _write
+#else
+#   include <unistd.h>
+#endif
+#include "report.h"
+
+#define REPORT_ESCAPE_RATIO     (6)         /* "\u00XX" is the longest escape of a byte */
+#define REPORT_BASE_SIZE        (4096)      /* headers, labels and numbers of a job */
+#define REPORT_NAME_SIZE        (32)        /* decoration around an extension name */
+#define REPORT_LIMIT_SIZE       (160)       /* one limit entry */
+#define REPORT_FBCONFIG_SIZE    (512)       /* one framebuffer config entry */
+#define REPORT_SHADERS_SIZE     (4096)      /* shader benchmark, in any format */
+#define REPORT_FORMAT_SIZE      (256)       /* one internal format entry */
+
+/* state of the extension visitor */
+typedef struct report_list
+{
+    GLINFO_REPORT   * report;
+    GLINFO_FORMAT   format;
+    const char      * profile;      /* CSV rows */
+    const char      * section;      /* CSV rows */
+    GLuint          count;
+} REPORT_LIST;
+
+static const char * reportCaveats[] = {"none", "slow", "non-conformant"};
+
+/* upper bound of the rendered size, so that the buffer is allocated once */
+static size_t reportEstimate(const GLINFO_JOB * jobs, GLuint count)
+{
+    const OGLI_CONTEXT  * ctx;
+    size_t              size = REPORT_BASE_SIZE;
+    GLuint              idx;
+
+    for (idx = 0; idx < count; idx++)
+    {
+        ctx = jobs[idx].ctx;
+        size += REPORT_BASE_SIZE + REPORT_ESCAPE_RATIO * (5 * OGLI_MAX_INFO_LENGTH + 
+                ctx->iblock.glExtensions.size + ctx->iblock.gluExtensions.size) +
+                REPORT_NAME_SIZE * (ctx->iblock.glExtensions.count + ctx->iblock.gluExtensions.count) +
+                REPORT_LIMIT_SIZE * OGLI_MAX_LIMITS + REPORT_FBCONFIG_SIZE * ctx->totalFBConfigs + REPORT_SHADERS_SIZE;
+        if (ctx->iblock.formatSource != OGLI_FORMATS_NONE)
+            size += REPORT_FORMAT_SIZE * ogliFormatCount();
+        if (jobs[idx].error)
+            size += REPORT_ESCAPE_RATIO * strlen(jobs[idx].error);
+        if (jobs[idx].display)  /* repeated on each CSV row */
+            size += (strlen(jobs[idx].display) + REPORT_NAME_SIZE) * (ctx->iblock.glExtensions.count + 
+                    ctx->iblock.gluExtensions.count + OGLI_MAX_LIMITS + ctx->totalFBConfigs + REPORT_NAME_SIZE);
+    }
+    return size;
+}
+
+/* the estimate makes growing exceptional, it is kept as a safety net */
+static GLboolean reportReserve(GLINFO_REPORT * report, size_t extra)
+{
+    char    * data;
+    size_t  size;
+
+    if (report->used + extra <= report->size)
+        return GL_TRUE;
+    if (report->failed)
+        return GL_FALSE;
+
+    size = (report->used + extra) * 2;
+    data = (char *) realloc(report->data, size);
+    if (!data)
+    {
+        report->failed = GL_TRUE;
+        return GL_FALSE;
+    }
+    report->data = data;
+    report->size = size;
+    return GL_TRUE;
+}
+
+static void reportPrintf(GLINFO_REPORT * report, const char * format, ...)
+{
+    va_list args;
+    int     length;
+
+    va_start(args, format);
+    length = vsnprintf(report->data + report->used, report->size - report->used, format, args);
+    va_end(args);
+    if (length < 0)
+        return;
+
+    if ((size_t) length >= report->size - report->used)
+    {
+        if (!reportReserve(report, length + 1))
+            return;
+        va_start(args, format);
+        vsnprintf(report->data + report->used, report->size - report->used, format, args);
+        va_end(args);
+    }
+    report->used += length;
+}
+
+/* JSON string, quotes included */
+static void reportJsonString(GLINFO_REPORT * report, const char * text, size_t length)
+{
+    static const char   hex[] = "0123456789abcdef";
+    unsigned char       c;
+    char                * out;
+    size_t              idx;
+
+    if (!reportReserve(report, length * REPORT_ESCAPE_RATIO + 3))
+        return;
+
+    out = report->data + report->used;
+    *out++ = '"';
+    for (idx = 0; idx < length; idx++)
+    {
+        c = (unsigned char) text[idx];
+        switch (c)
+        {
+            case '"':   *out++ = '\\'; *out++ = '"';  break;
+            case '\\':  *out++ = '\\'; *out++ = '\\'; break;
+            case '\n':  *out++ = '\\'; *out++ = 'n';  break;
+            case '\r':  *out++ = '\\'; *out++ = 'r';  break;
+            case '\t':  *out++ = '\\'; *out++ = 't';  break;
+            default:
+                if (c < 0x20)
+                {
+                    memcpy(out, "\\u00", 4);
+                    out[4] = hex[c >> 4];
+                    out[5] = hex[c & 15];
+                    out += 6;
+                }
+                else
+                    *out++ = (char) c;
+        }
+    }
+    *out++ = '"';
+    *out = 0;
+    report->used = out - report->data;
+}
+
+/* CSV field, quoted only when it holds a separator, a quote or a line break */
+static void reportCsvField(GLINFO_REPORT * report, const char * text, size_t length)
+{
+    char    * out;
+    size_t  idx;
+
+    if (!reportReserve(report, length * 2 + 3))
+        return;
+
+    out = report->data + report->used;
+    if (strcspn(text, ",\"\r\n") >= length)
+    {
+        memcpy(out, text, length);
+        out += length;
+    }
+    else
+    {
+        *out++ = '"';
+        for (idx = 0; idx < length; idx++)
+        {
+            if (text[idx] == '"')
+                *out++ = '"';
+            *out++ = text[idx];
+        }
+        *out++ = '"';
+    }
+    *out = 0;
+    report->used = out - report->data;
+}
+
+/* CSV row, the value is the only free-form field */
+static void reportCsvRow(GLINFO_REPORT * report, const char * profile, const char * section, 
+                         const char * name, const char * value, size_t length)
+{
+    reportPrintf(report, "%s,%s,", profile, section);
+    reportCsvField(report, name, strlen(name));
+    reportPrintf(report, ",");
+    reportCsvField(report, value, length);
+    reportPrintf(report, "\n");
+}
+
+static void reportCsvString(GLINFO_REPORT * report, const char * profile, const char * section, 
+                            const char * name, const char * value)
+{
+    reportCsvRow(report, profile, section, name, value, strlen(value));
+}
+
+/* starts a member of a JSON object, members are separated as they come */
+static void reportJsonKey(GLINFO_REPORT * report, GLuint depth, GLboolean * first, const char * key)
+{
+    reportPrintf(report, "%s\n%*s\"%s\": ", *first ? "" : ",", depth * 2, "", key);
+    *first = GL_FALSE;
+}
+
+static void reportJsonText(GLINFO_REPORT * report, GLuint depth, GLboolean * first, const char * key, const char * value)
+{
+    reportJsonKey(report, depth, first, key);
+    reportJsonString(report, value, strlen(value));
+}
+
+static void reportJsonVersion(GLINFO_REPORT * report, GLuint depth, GLboolean * first, const char * key, 
+                              const OGLI_GL_VERSION_BLOCK * version)
+{
+    reportJsonKey(report, depth, first, key);
+    if (version->major)
+        reportPrintf(report, "\"%d.%d\"", version->major, version->minor);
+    else
+        reportPrintf(report, "null");
+}
+
+static GLboolean reportExtension(const char * name, GLuint length, void * user)
+{
+    REPORT_LIST * list = (REPORT_LIST *) user;
+
+    switch (list->format)
+    {
+        case GLINFO_FORMAT_JSON:
+            reportPrintf(list->report, "%s\n      ", list->count ? "," : "");
+            reportJsonString(list->report, name, length);
+            break;
+        case GLINFO_FORMAT_CSV:
+            reportCsvRow(list->report, list->profile, list->section, "extension", name, length);
+            break;
+        default:
+            reportPrintf(list->report, "%4d %.*s\n", list->count + 1, (int) length, name);
+    }
+    list->count++;
+    return GL_TRUE;
+}
+
+static void reportExtensions(GLINFO_REPORT * report, GLINFO_FORMAT format, const OGLI_CONTEXT * ctx, 
+                             OGLI_EXT_SOURCE source)
+{
+    REPORT_LIST list;
+
+    list.report = report;
+    list.format = format;
+    list.profile = ogliProfileName(ctx->profile);
+    list.section = source == OGLI_EXT_GL ? "gl" : "glu";
+    list.count = 0;
+    ogliForEachExtension(ctx, source, reportExtension, &list);
+}
+
+/*------------------------------------------------------------------------------------------------*/
+/*                                          TEXT                                                  */
+/*------------------------------------------------------------------------------------------------*/
+
+static void reportTextMaxVersion(GLINFO_REPORT * report, const char * label, const OGLI_GL_VERSION_BLOCK * version)
+{
+    if (version->major)
+        reportPrintf(report, " . %-11s : %d.%d\n", label, version->major, version->minor);
+    else
+        reportPrintf(report, " . %-11s : None\n", label);
+}
+
+/* the identity fields are left out when the driver cannot tell them */
+static void reportTextRenderer(GLINFO_REPORT * report, const OGLI_CONTEXT * ctx)
+{
+    const GL_INFO_BLOCK * block = &ctx->iblock;
+    const OGLI_RENDERER * renderer = &block->renderer;
+
+    reportPrintf(report, "\n>>> Renderer (%s)\n", ogliRendererSourceName(renderer->source));
+    reportPrintf(report, " . Vendor      : %s\n", block->glVendor);
+    reportPrintf(report, " . Renderer    : %s\n", block->glRenderer);
+    if (renderer->source == OGLI_RENDERER_NONE)
+        return;
+    reportPrintf(report, " . PCI ID      : %04x:%04x\n", renderer->vendorId, renderer->deviceId);
+    reportPrintf(report, " . VRAM        : %u MB\n", renderer->videoMemory);
+    reportPrintf(report, " . Accelerated : %s\n", renderer->accelerated ? "yes" : "no");
+    reportPrintf(report, " . Unified mem : %s\n", renderer->unifiedMemory ? "yes" : "no");
+    reportTextMaxVersion(report, "Max core", &block->maxCore);
+    reportTextMaxVersion(report, "Max compat", &block->maxCompat);
+}
+
+static void reportTextLimits(GLINFO_REPORT * report, const OGLI_CONTEXT * ctx)
+{
+    const OGLI_LIMIT    * limit;
+    GLuint              idx, value;
+
+    reportPrintf(report, "\n>>> Limits (%u available)\n", ctx->iblock.totalLimits);
+    for (idx = 0; idx < ogliLimitCount(); idx++)
+    {
+        limit = &ctx->iblock.limits[idx];
+        if (!limit->count)
+            continue;
+
+        reportPrintf(report, " . %-38s:", ogliLimitName(idx));
+        for (value = 0; value < limit->count; value++)
+            reportPrintf(report, "%s %lld", value ? "," : "", (long long) limit->values[value]);
+        reportPrintf(report, "\n");
+    }
+}
+
+static void reportTextFBConfigs(GLINFO_REPORT * report, const OGLI_CONTEXT * ctx)
+{
+    const OGLI_FBCONFIG * config;
+    GLuint              idx;
+
+    reportPrintf(report, "\n>>> Framebuffer configs (%u total)\n", ctx->totalFBConfigs);
+    if (!ctx->totalFBConfigs)
+        return;
+
+    reportPrintf(report, "    id visual  r  g  b  a depth stencil ms db st srgb drawables caveat\n");
+    for (idx = 0; idx < ctx->totalFBConfigs; idx++)
+    {
+        config = &ctx->fbconfigs[idx];
+        reportPrintf(report, "%6x %6x %2d %2d %2d %2d %5d %7d %2d %2s %2s %4s %c%c%c       %s\n", 
+                     config->id, config->visualId, config->red, config->green, config->blue, config->alpha,
+                     config->depth, config->stencil, config->samples,
+                     config->doubleBuffer ? "y" : ".", config->stereo ? "y" : ".", config->sRGB ? "y" : ".",
+                     config->drawables & OGLI_FBCONFIG_WINDOW  ? 'W' : '.',
+                     config->drawables & OGLI_FBCONFIG_PIXMAP  ? 'X' : '.',
+                     config->drawables & OGLI_FBCONFIG_PBUFFER ? 'P' : '.',
+                     reportCaveats[config->caveat]);
+    }
+}
+
+/* name of a pixel format or type, hexadecimal when the library does not know it */
+static const char * reportPixel(char * text, GLenum value)
+{
+    const char * name = ogliPixelName(value);
+
+    if (name)
+        return name;
+    sprintf(text, "0x%04X", value);
+    return text;
+}
+
+static void reportTextFormats(GLINFO_REPORT * report, const OGLI_CONTEXT * ctx)
+{
+    const OGLI_FORMAT   * format;
+    char                pixel[2][16];
+    GLuint              idx;
+
+    reportPrintf(report, "\n>>> Internal formats (%u supported, %s)\n", ctx->iblock.totalFormats, 
+                 ogliFormatSourceName(ctx->iblock.formatSource));
+    reportPrintf(report, "    %-33s %-26s cr dr samples upload\n", "format", "target");
+    for (idx = 0; idx < ogliFormatCount(); idx++)
+    {
+        format = &ctx->iblock.formats[idx];
+        reportPrintf(report, "    %-33s %-26s ", ogliFormatName(idx), ogliFormatTarget(idx));
+        if (!format->flags)
+            reportPrintf(report, "not supported\n");
+        else
+            reportPrintf(report, "%2s %2s %7d %s %s\n", 
+                         format->flags & OGLI_FORMAT_COLOR_RENDERABLE ? "y" : ".",
+                         format->flags & OGLI_FORMAT_DEPTH_RENDERABLE ? "y" : ".", format->maxSamples,
+                         reportPixel(pixel[0], format->format), reportPixel(pixel[1], format->type));
+    }
+}
+
+static void reportTextTimings(GLINFO_REPORT * report, const OGLI_CONTEXT * ctx)
+{
+    const OGLI_TIMING   * timing = ogliGetTimings(ctx);
+    double              total = 0;
+    GLuint              idx;
+
+    reportPrintf(report, "\n>>> Timings\n");
+    for (idx = 0; idx < OGLI_TOTAL_PHASES; idx++)
+    {
+        if (!timing[idx].count)
+            continue;
+        reportPrintf(report, " . %-11s : %8.3f ms\n", ogliPhaseName((OGLI_PHASE) idx), timing[idx].duration * 1e3);
+        total += timing[idx].duration;
+    }
+    reportPrintf(report, " . %-11s : %8.3f ms\n", "total", total * 1e3);
+}
+
+static void reportTextShaders(GLINFO_REPORT * report, const GLINFO_SHADER_BENCH * bench)
+{
+    const GLINFO_SHADER_PROGRAM * program;
+    GLuint                      idx;
+
+    reportPrintf(report, "\n>>> Shader benchmark (p50/p99 in ms)\n");
+    for (idx = 0; idx < GLINFO_SHADER_PROGRAMS; idx++)
+    {
+        program = &bench->programs[idx];
+        reportPrintf(report, " . %-12s: compile %.2f/%.2f, link %.2f/%.2f, ", program->name,
+                     program->compile[0], program->compile[1], program->link[0], program->link[1]);
+        if (bench->binary)
+            reportPrintf(report, "reload %.2f/%.2f, ", program->reload[0], program->reload[1]);
+        else
+            reportPrintf(report, "reload n/a, ");
+        reportPrintf(report, "%u bytes, %u runs\n", program->sourceSize, program->runs);
+    }
+    reportPrintf(report, " . Serial      : %.1f programs/s\n", bench->serialRate);
+    if (bench->parallel && bench->threads)
+        reportPrintf(report, " . Parallel    : %.1f programs/s, %u threads\n", bench->parallelRate, bench->threads);
+    else if (bench->parallel)
+        reportPrintf(report, " . Parallel    : %.1f programs/s, threads picked by the driver\n", bench->parallelRate);
+    else
+        reportPrintf(report, " . Parallel    : not supported\n");
+}
+
+static void reportTextChurn(GLINFO_REPORT * report, const GLINFO_CHURN_BENCH * bench)
+{
+    const GLINFO_CHURN_MODE * mode;
+    GLuint                  idx;
+
+    reportPrintf(report, "\n>>> Context churn benchmark (p50/p99 in ms, %u runs)\n", bench->runs);
+    for (idx = 0; idx < GLINFO_CHURN_MODES; idx++)
+    {
+        mode = &bench->modes[idx];
+        reportPrintf(report, " . %-12s: create %.3f/%.3f, destroy %.3f/%.3f, %.1f contexts/s", mode->name,
+                     mode->create[0], mode->create[1], mode->destroy[0], mode->destroy[1], mode->rate);
+        if (bench->footprint)
+            reportPrintf(report, ", %+ld KB, %+d fds", mode->rssGrowth, mode->fdGrowth);
+        reportPrintf(report, "\n");
+    }
+    reportPrintf(report, " . Phases      : display %.3f, config %.3f, context %.3f, current %.3f, destroy %.3f\n",
+                 bench->phases[OGLI_PHASE_DISPLAY], bench->phases[OGLI_PHASE_CONFIG], bench->phases[OGLI_PHASE_CONTEXT],
+                 bench->phases[OGLI_PHASE_CURRENT], bench->phases[OGLI_PHASE_DESTROY]);
+}
+
+static void reportText(GLINFO_REPORT * report, const GLINFO_SECTIONS * sections, const GLINFO_JOB * job)
+{
+    const OGLI_CONTEXT  * ctx = job->ctx;
+    const GL_INFO_BLOCK * block = &ctx->iblock;
+    size_t              start = report->used;
+
+    /* --quick and the benchmarks alone have nothing to show under OpenGL */
+    if (sections->info || sections->extensions)
+        reportPrintf(report, ">>> OpenGL\n");
+    if (sections->info)
+    {
+        reportPrintf(report, " . Vendor      : %s\n", block->glVendor);
+        reportPrintf(report, " . Renderer    : %s\n", block->glRenderer);
+        reportPrintf(report, " . Version     : %s\n", block->glVersion);
+        reportPrintf(report, " . GLSL        : %s\n", block->glSL);
+        reportPrintf(report, " . Extensions  : %u total\n", block->totalExtensions);
+        if (sections->maxVersion)
+        {
+            reportTextMaxVersion(report, "Max core", &block->maxCore);
+            reportTextMaxVersion(report, "Max compat", &block->maxCompat);
+        }
+    }
+
+    if (sections->extensions)
+        reportExtensions(report, GLINFO_FORMAT_TEXT, ctx, OGLI_EXT_GL);
+
+    if (sections->limits)
+        reportTextLimits(report, ctx);
+
+    /* -i alone does not query GLU, its section would be empty */
+    if ((sections->info && sections->glu) || sections->extensions)
+    {
+        reportPrintf(report, "\n>>> OpenGLU\n");
+        if (sections->info && sections->glu)
+            reportPrintf(report, " . Version     : %s\n", block->gluVersion);
+
+        if (sections->extensions)
+            reportExtensions(report, GLINFO_FORMAT_TEXT, ctx, OGLI_EXT_GLU);
+    }
+
+    if (sections->renderer)
+        reportTextRenderer(report, ctx);
+
+    if (sections->raster)
+    {
+        reportPrintf(report, "\n>>> Raster benchmark (%dx%d offscreen)\n", GLINFO_BENCH_SIZE, GLINFO_BENCH_SIZE);
+        reportPrintf(report, " . Fill opaque : %.1f Mpix/s\n", job->raster.fillOpaque);
+        reportPrintf(report, " . Fill blend  : %.1f Mpix/s\n", job->raster.fillBlended);
+        reportPrintf(report, " . Small tris  : %.2f Mtri/s\n", job->raster.trisSmall);
+        reportPrintf(report, " . Large tris  : %.2f Mtri/s\n", job->raster.trisLarge);
+    }
+
+    if (sections->shaders)
+        reportTextShaders(report, &job->shaders);
+
+    if (sections->churn)
+        reportTextChurn(report, &job->churn);
+
+    if (sections->formats)
+        reportTextFormats(report, ctx);
+
+    if (sections->fbconfigs)
+        reportTextFBConfigs(report, ctx);
+
+    if (sections->timings)
+        reportTextTimings(report, ctx);
+
+    /* the first section printed loses the blank line that separates it from the previous one */
+    if (report->used > start && report->data[start] == '\n')
+    {
+        memmove(report->data + start, report->data + start + 1, report->used - start);
+        report->used--;
+    }
+}
+
+/*------------------------------------------------------------------------------------------------*/
+/*                                          JSON                                                  */
+/*------------------------------------------------------------------------------------------------*/
+
+static void reportJsonRenderer(GLINFO_REPORT * report, const OGLI_CONTEXT * ctx)
+{
+    const GL_INFO_BLOCK * block = &ctx->iblock;
+    const OGLI_RENDERER * renderer = &block->renderer;
+    GLboolean           first = GL_TRUE;
+
+    reportPrintf(report, "{");
+    reportJsonText(report, 2, &first, "source", ogliRendererSourceName(renderer->source));
+    reportJsonText(report, 2, &first, "vendor", block->glVendor);
+    reportJsonText(report, 2, &first, "renderer", block->glRenderer);
+    if (renderer->source != OGLI_RENDERER_NONE)
+    {
+        reportJsonKey(report, 2, &first, "vendorId");
+        reportPrintf(report, "%u", renderer->vendorId);
+        reportJsonKey(report, 2, &first, "deviceId");
+        reportPrintf(report, "%u", renderer->deviceId);
+        reportJsonKey(report, 2, &first, "videoMemoryMB");
+        reportPrintf(report, "%u", renderer->videoMemory);
+        reportJsonKey(report, 2, &first, "accelerated");
+        reportPrintf(report, "%s", renderer->accelerated ? "true" : "false");
+        reportJsonKey(report, 2, &first, "unifiedMemory");
+        reportPrintf(report, "%s", renderer->unifiedMemory ? "true" : "false");
+        reportJsonVersion(report, 2, &first, "maxCore", &block->maxCore);
+        reportJsonVersion(report, 2, &first, "maxCompat", &block->maxCompat);
+    }
+    reportPrintf(report, "\n  }");
+}
+
+static void reportJsonLimits(GLINFO_REPORT * report, const OGLI_CONTEXT * ctx)
+{
+    const OGLI_LIMIT    * limit;
+    GLboolean           first = GL_TRUE;
+    GLuint              idx, value;
+
+    reportPrintf(report, "{");
+    for (idx = 0; idx < ogliLimitCount(); idx++)
+    {
+        limit = &ctx->iblock.limits[idx];
+        if (!limit->count)
+            continue;
+
+        reportJsonKey(report, 2, &first, ogliLimitName(idx));
+        if (limit->count == 1)
+            reportPrintf(report, "%lld", (long long) limit->values[0]);
+        else
+        {
+            for (value = 0; value < limit->count; value++)
+                reportPrintf(report, "%s%lld", value ? ", " : "[", (long long) limit->values[value]);
+            reportPrintf(report, "]");
+        }
+    }
+    reportPrintf(report, "\n  }");
+}
+
+static void reportJsonFBConfigs(GLINFO_REPORT * report, const OGLI_CONTEXT * ctx)
+{
+    const OGLI_FBCONFIG * config;
+    GLuint              idx;
+
+    reportPrintf(report, "[");
+    for (idx = 0; idx < ctx->totalFBConfigs; idx++)
+    {
+        config = &ctx->fbconfigs[idx];
+        reportPrintf(report, "%s\n    {\"id\": %d, \"visualId\": %d, \"red\": %d, \"green\": %d, \"blue\": %d, \"alpha\": %d, "
+                     "\"depth\": %d, \"stencil\": %d, \"samples\": %d, \"doubleBuffer\": %s, \"stereo\": %s, \"sRGB\": %s, "
+                     "\"window\": %s, \"pixmap\": %s, \"pbuffer\": %s, \"caveat\": \"%s\"}",
+                     idx ? "," : "", config->id, config->visualId, config->red, config->green, config->blue, 
+                     config->alpha, config->depth, config->stencil, config->samples,
+                     config->doubleBuffer ? "true" : "false", config->stereo ? "true" : "false", 
+                     config->sRGB ? "true" : "false",
+                     config->drawables & OGLI_FBCONFIG_WINDOW  ? "true" : "false",
+                     config->drawables & OGLI_FBCONFIG_PIXMAP  ? "true" : "false",
+                     config->drawables & OGLI_FBCONFIG_PBUFFER ? "true" : "false",
+                     reportCaveats[config->caveat]);
+    }
+    reportPrintf(report, "%s]", ctx->totalFBConfigs ? "\n  " : "");
+}
+
+static void reportJsonFormats(GLINFO_REPORT * report, const OGLI_CONTEXT * ctx)
+{
+    const OGLI_FORMAT   * format;
+    char                pixel[2][16];
+    GLuint              idx;
+
+    reportPrintf(report, "{\n    \"source\": \"%s\",\n    \"entries\": [", ogliFormatSourceName(ctx->iblock.formatSource));
+    for (idx = 0; idx < ogliFormatCount(); idx++)
+    {
+        format = &ctx->iblock.formats[idx];
+        reportPrintf(report, "%s\n      {\"format\": \"%s\", \"target\": \"%s\", \"supported\": %s",
+                     idx ? "," : "", ogliFormatName(idx), ogliFormatTarget(idx), format->flags ? "true" : "false");
+        if (format->flags)
+            reportPrintf(report, ", \"imageFormat\": \"%s\", \"imageType\": \"%s\", \"colorRenderable\": %s, "
+                         "\"depthRenderable\": %s, \"maxSamples\": %d",
+                         reportPixel(pixel[0], format->format), reportPixel(pixel[1], format->type),
+                         format->flags & OGLI_FORMAT_COLOR_RENDERABLE ? "true" : "false",
+                         format->flags & OGLI_FORMAT_DEPTH_RENDERABLE ? "true" : "false", format->maxSamples);
+        reportPrintf(report, "}");
+    }
+    reportPrintf(report, "\n    ]\n  }");
+}
+
+/* durations in milliseconds */
+static void reportJsonTimings(GLINFO_REPORT * report, const OGLI_CONTEXT * ctx)
+{
+    const OGLI_TIMING   * timing = ogliGetTimings(ctx);
+    GLboolean           first = GL_TRUE;
+    double              total = 0;
+    GLuint              idx;
+
+    reportPrintf(report, "{");
+    for (idx = 0; idx < OGLI_TOTAL_PHASES; idx++)
+    {
+        if (!timing[idx].count)
+            continue;
+        reportJsonKey(report, 2, &first, ogliPhaseName((OGLI_PHASE) idx));
+        reportPrintf(report, "%.3f", timing[idx].duration * 1e3);
+        total += timing[idx].duration;
+    }
+    reportJsonKey(report, 2, &first, "total");
+    reportPrintf(report, "%.3f\n  }", total * 1e3);
+}
+
+static void reportJsonShaders(GLINFO_REPORT * report, const GLINFO_SHADER_BENCH * bench)
+{
+    const GLINFO_SHADER_PROGRAM * program;
+    GLuint                      idx;
+
+    reportPrintf(report, "{\n    \"programBinary\": %s,\n    \"parallelCompile\": %s,\n    \"programs\": [",
+                 bench->binary ? "true" : "false", bench->parallel ? "true" : "false");
+    for (idx = 0; idx < GLINFO_SHADER_PROGRAMS; idx++)
+    {
+        program = &bench->programs[idx];
+        reportPrintf(report, "%s\n      {\"name\": \"%s\", \"sourceBytes\": %u, \"runs\": %u, "
+                     "\"compileP50\": %.3f, \"compileP99\": %.3f, \"linkP50\": %.3f, \"linkP99\": %.3f",
+                     idx ? "," : "", program->name, program->sourceSize, program->runs,
+                     program->compile[0], program->compile[1], program->link[0], program->link[1]);
+        if (bench->binary)
+            reportPrintf(report, ", \"reloadP50\": %.3f, \"reloadP99\": %.3f, \"binaryBytes\": %u",
+                         program->reload[0], program->reload[1], program->binarySize);
+        reportPrintf(report, "}");
+    }
+    reportPrintf(report, "\n    ],\n    \"serialRate\": %.1f", bench->serialRate);
+    if (bench->parallel)
+        reportPrintf(report, ",\n    \"parallelRate\": %.1f,\n    \"compilerThreads\": %u", bench->parallelRate, bench->threads);
+    reportPrintf(report, "\n  }");
+}
+
+static void reportJsonChurn(GLINFO_REPORT * report, const GLINFO_CHURN_BENCH * bench)
+{
+    static const OGLI_PHASE     phases[] = {OGLI_PHASE_DISPLAY, OGLI_PHASE_CONFIG, OGLI_PHASE_CONTEXT, 
+                                            OGLI_PHASE_CURRENT, OGLI_PHASE_DESTROY};
+    const GLINFO_CHURN_MODE     * mode;
+    GLuint                      idx;
+
+    reportPrintf(report, "{\n    \"runs\": %u,\n    \"modes\": [", bench->runs);
+    for (idx = 0; idx < GLINFO_CHURN_MODES; idx++)
+    {
+        mode = &bench->modes[idx];
+        reportPrintf(report, "%s\n      {\"name\": \"%s\", \"createP50\": %.3f, \"createP99\": %.3f, "
+                     "\"destroyP50\": %.3f, \"destroyP99\": %.3f, \"rate\": %.1f",
+                     idx ? "," : "", mode->name, mode->create[0], mode->create[1],
+                     mode->destroy[0], mode->destroy[1], mode->rate);
+        if (bench->footprint)
+            reportPrintf(report, ", \"rssGrowthKB\": %ld, \"fdGrowth\": %d", mode->rssGrowth, mode->fdGrowth);
+        reportPrintf(report, "}");
+    }
+    reportPrintf(report, "\n    ],\n    \"phases\": {");
+    for (idx = 0; idx < sizeof(phases) / sizeof(phases[0]); idx++)
+        reportPrintf(report, "%s\"%s\": %.3f", idx ? ", " : "", ogliPhaseName(phases[idx]), bench->phases[phases[idx]]);
+    reportPrintf(report, "}\n  }");
+}
+
+static void reportJson(GLINFO_REPORT * report, const GLINFO_SECTIONS * sections, const GLINFO_JOB * job)
+{
+    const OGLI_CONTEXT  * ctx = job->ctx;
+    const GL_INFO_BLOCK * block = &ctx->iblock;
+    GLboolean           first = GL_TRUE, inner;
+
+    reportPrintf(report, "{");
+    reportJsonText(report, 1, &first, "profile", ogliProfileName(ctx->profile));
+    if (job->display)
+    {
+        reportJsonText(report, 1, &first, "display", job->display);
+        if (job->screen >= 0)
+        {
+            reportJsonKey(report, 1, &first, "screen");
+            reportPrintf(report, "%d", job->screen);
+        }
+    }
+    if (job->error)
+    {
+        reportJsonText(report, 1, &first, "error", job->error);
+        reportPrintf(report, "\n}");
+        return;
+    }
+
+    if (sections->info || sections->extensions)
+    {
+        reportJsonKey(report, 1, &first, "gl");
+        reportPrintf(report, "{");
+        inner = GL_TRUE;
+        if (sections->info)
+        {
+            reportJsonText(report, 2, &inner, "vendor", block->glVendor);
+            reportJsonText(report, 2, &inner, "renderer", block->glRenderer);
+            reportJsonText(report, 2, &inner, "version", block->glVersion);
+            reportJsonKey(report, 2, &inner, "versionMajor");
+            reportPrintf(report, "%d", block->versionGL.major);
+            reportJsonKey(report, 2, &inner, "versionMinor");
+            reportPrintf(report, "%d", block->versionGL.minor);
+            reportJsonText(report, 2, &inner, "glsl", block->glSL);
+            reportJsonKey(report, 2, &inner, "extensionCount");
+            reportPrintf(report, "%u", block->totalExtensions);
+            if (sections->maxVersion)
+            {
+                reportJsonVersion(report, 2, &inner, "maxCore", &block->maxCore);
+                reportJsonVersion(report, 2, &inner, "maxCompat", &block->maxCompat);
+            }
+        }
+        if (sections->extensions)
+        {
+            reportJsonKey(report, 2, &inner, "extensions");
+            reportPrintf(report, "[");
+            reportExtensions(report, GLINFO_FORMAT_JSON, ctx, OGLI_EXT_GL);
+            reportPrintf(report, "%s]", block->glExtensions.count ? "\n    " : "");
+        }
+        reportPrintf(report, "\n  }");
+    }
+
+    if ((sections->info && sections->glu) || sections->extensions)
+    {
+        reportJsonKey(report, 1, &first, "glu");
+        reportPrintf(report, "{");
+        inner = GL_TRUE;
+        if (sections->info && sections->glu)
+            reportJsonText(report, 2, &inner, "version", block->gluVersion);
+        if (sections->extensions)
+        {
+            reportJsonKey(report, 2, &inner, "extensions");
+            reportPrintf(report, "[");
+            reportExtensions(report, GLINFO_FORMAT_JSON, ctx, OGLI_EXT_GLU);
+            reportPrintf(report, "%s]", block->gluExtensions.count ? "\n    " : "");
+        }
+        reportPrintf(report, "\n  }");
+    }
+
+    if (sections->renderer)
+    {
+        reportJsonKey(report, 1, &first, "renderer");
+        reportJsonRenderer(report, ctx);
+    }
+
+    if (sections->limits)
+    {
+        reportJsonKey(report, 1, &first, "limits");
+        reportJsonLimits(report, ctx);
+    }
+
+    if (sections->raster)
+    {
+        reportJsonKey(report, 1, &first, "raster");
+        reportPrintf(report, "{\"size\": %d, \"fillOpaque\": %.1f, \"fillBlended\": %.1f, \"trisSmall\": %.3f, \"trisLarge\": %.3f}",
+                     GLINFO_BENCH_SIZE, job->raster.fillOpaque, job->raster.fillBlended, 
+                     job->raster.trisSmall, job->raster.trisLarge);
+    }
+
+    if (sections->shaders)
+    {
+        reportJsonKey(report, 1, &first, "shaders");
+        reportJsonShaders(report, &job->shaders);
+    }
+
+    if (sections->churn)
+    {
+        reportJsonKey(report, 1, &first, "churn");
+        reportJsonChurn(report, &job->churn);
+    }
+
+    if (sections->formats)
+    {
+        reportJsonKey(report, 1, &first, "formats");
+        reportJsonFormats(report, ctx);
+    }
+
+    if (sections->fbconfigs)
+    {
+        reportJsonKey(report, 1, &first, "fbconfigs");
+        reportJsonFBConfigs(report, ctx);
+    }
+
+    if (sections->timings)
+    {
+        reportJsonKey(report, 1, &first, "timings");
+        reportJsonTimings(report, ctx);
+    }
+    reportPrintf(report, "\n}");
+}
+
+/*------------------------------------------------------------------------------------------------*/
+/*                                          CSV                                                   */
+/*------------------------------------------------------------------------------------------------*/
+
+static void reportCsvNumber(GLINFO_REPORT * report, const char * profile, const char * section, 
+                            const char * name, const char * format, double value)
+{
+    char text[64];
+
+    snprintf(text, sizeof(text), format, value);
+    reportCsvString(report, profile, section, name, text);
+}
+
+static void reportCsvVersion(GLINFO_REPORT * report, const char * profile, const char * section, 
+                             const char * name, const OGLI_GL_VERSION_BLOCK * version)
+{
+    char text[32] = "";
+
+    if (version->major)
+        snprintf(text, sizeof(text), "%d.%d", version->major, version->minor);
+    reportCsvString(report, profile, section, name, text);
+}
+
+/* profile, separator, display and screen of a --displays job */
+static void reportLabel(char * label, size_t size, const GLINFO_JOB * job, const char * separator)
+{
+    const char * profile = ogliProfileName(job->ctx->profile);
+
+    if (job->screen >= 0)
+        snprintf(label, size, "%s%s%s.%d", profile, separator, job->display, job->screen);
+    else
+        snprintf(label, size, "%s%s%s", profile, separator, job->display);
+}
+
+static void reportCsvFormat(GLINFO_REPORT * report, const char * profile, GLuint index, const OGLI_FORMAT * format)
+{
+    char name[80], text[128], pixel[2][16];
+
+    snprintf(name, sizeof(name), "%s %s", ogliFormatName(index), ogliFormatTarget(index));
+    snprintf(text, sizeof(text), "upload=%s/%s color=%d depth=%d samples=%d",
+             reportPixel(pixel[0], format->format), reportPixel(pixel[1], format->type),
+             (format->flags & OGLI_FORMAT_COLOR_RENDERABLE) != 0, 
+             (format->flags & OGLI_FORMAT_DEPTH_RENDERABLE) != 0, format->maxSamples);
+    reportCsvString(report, profile, "format", name, text);
+}
+
+static void reportCsvShaders(GLINFO_REPORT * report, const char * profile, const GLINFO_SHADER_BENCH * bench)
+{
+    static const char           * stats[3] = {"compile", "link", "reload"};
+    const GLINFO_SHADER_PROGRAM * program;
+    const double                * values;
+    char                        name[64];
+    GLuint                      idx, stat;
+
+    for (idx = 0; idx < GLINFO_SHADER_PROGRAMS; idx++)
+    {
+        program = &bench->programs[idx];
+        for (stat = 0; stat < (bench->binary ? 3u : 2u); stat++)
+        {
+            values = stat == 0 ? program->compile : stat == 1 ? program->link : program->reload;
+            snprintf(name, sizeof(name), "%s_%s_p50_ms", program->name, stats[stat]);
+            reportCsvNumber(report, profile, "shaders", name, "%.3f", values[0]);
+            snprintf(name, sizeof(name), "%s_%s_p99_ms", program->name, stats[stat]);
+            reportCsvNumber(report, profile, "shaders", name, "%.3f", values[1]);
+        }
+    }
+    reportCsvNumber(report, profile, "shaders", "serial_rate", "%.1f", bench->serialRate);
+    if (bench->parallel)
+        reportCsvNumber(report, profile, "shaders", "parallel_rate", "%.1f", bench->parallelRate);
+}
+
+static void reportCsvChurn(GLINFO_REPORT * report, const char * profile, const GLINFO_CHURN_BENCH * bench)
+{
+    const GLINFO_CHURN_MODE * mode;
+    char                    name[64];
+    GLuint                  idx;
+
+    for (idx = 0; idx < GLINFO_CHURN_MODES; idx++)
+    {
+        mode = &bench->modes[idx];
+        snprintf(name, sizeof(name), "%s_create_p50_ms", mode->name);
+        reportCsvNumber(report, profile, "churn", name, "%.3f", mode->create[0]);
+        snprintf(name, sizeof(name), "%s_create_p99_ms", mode->name);
+        reportCsvNumber(report, profile, "churn", name, "%.3f", mode->create[1]);
+        snprintf(name, sizeof(name), "%s_destroy_p50_ms", mode->name);
+        reportCsvNumber(report, profile, "churn", name, "%.3f", mode->destroy[0]);
+        snprintf(name, sizeof(name), "%s_destroy_p99_ms", mode->name);
+        reportCsvNumber(report, profile, "churn", name, "%.3f", mode->destroy[1]);
+        snprintf(name, sizeof(name), "%s_rate", mode->name);
+        reportCsvNumber(report, profile, "churn", name, "%.1f", mode->rate);
+        if (bench->footprint)
+        {
+            snprintf(name, sizeof(name), "%s_rss_growth_kb", mode->name);
+            reportCsvNumber(report, profile, "churn", name, "%.0f", (double) mode->rssGrowth);
+            snprintf(name, sizeof(name), "%s_fd_growth", mode->name);
+            reportCsvNumber(report, profile, "churn", name, "%.0f", (double) mode->fdGrowth);
+        }
+    }
+}
+
+static void reportCsv(GLINFO_REPORT * report, const GLINFO_SECTIONS * sections, const GLINFO_JOB * job)
+{
+    const OGLI_CONTEXT  * ctx = job->ctx;
+    const GL_INFO_BLOCK * block = &ctx->iblock;
+    const char          * profile = ogliProfileName(ctx->profile);
+    const OGLI_FBCONFIG * config;
+    const OGLI_LIMIT    * limit;
+    const OGLI_TIMING   * timing;
+    char                text[128], label[128];
+    size_t              used;
+    GLuint              idx, value;
+
+    /* rows of --displays runs are told apart by profile@display.screen */
+    if (job->display)
+    {
+        reportLabel(label, sizeof(label), job, "@");
+        profile = label;
+    }
+
+    if (job->error)
+    {
+        reportCsvString(report, profile, "error", "", job->error);
+        return;
+    }
+
+    if (sections->info)
+    {
+        reportCsvString(report, profile, "gl", "vendor", block->glVendor);
+        reportCsvString(report, profile, "gl", "renderer", block->glRenderer);
+        reportCsvString(report, profile, "gl", "version", block->glVersion);
+        reportCsvString(report, profile, "gl", "glsl", block->glSL);
+        reportCsvNumber(report, profile, "gl", "extensions", "%.0f", block->totalExtensions);
+        if (sections->maxVersion)
+        {
+            reportCsvVersion(report, profile, "gl", "max_core", &block->maxCore);
+            reportCsvVersion(report, profile, "gl", "max_compat", &block->maxCompat);
+        }
+        if (sections->glu)
+            reportCsvString(report, profile, "glu", "version", block->gluVersion);
+    }
+
+    if (sections->extensions)
+    {
+        reportExtensions(report, GLINFO_FORMAT_CSV, ctx, OGLI_EXT_GL);
+        reportExtensions(report, GLINFO_FORMAT_CSV, ctx, OGLI_EXT_GLU);
+    }
+
+    /* PCI IDs in hexadecimal, as lspci shows them */
+    if (sections->renderer)
+    {
+        reportCsvString(report, profile, "renderer", "source", ogliRendererSourceName(block->renderer.source));
+        reportCsvString(report, profile, "renderer", "vendor", block->glVendor);
+        reportCsvString(report, profile, "renderer", "renderer", block->glRenderer);
+        if (block->renderer.source != OGLI_RENDERER_NONE)
+        {
+            snprintf(text, sizeof(text), "%04x:%04x", block->renderer.vendorId, block->renderer.deviceId);
+            reportCsvString(report, profile, "renderer", "pci_id", text);
+            reportCsvNumber(report, profile, "renderer", "video_memory_mb", "%.0f", block->renderer.videoMemory);
+            reportCsvString(report, profile, "renderer", "accelerated", block->renderer.accelerated ? "yes" : "no");
+            reportCsvString(report, profile, "renderer", "unified_memory", block->renderer.unifiedMemory ? "yes" : "no");
+            reportCsvVersion(report, profile, "renderer", "max_core", &block->maxCore);
+            reportCsvVersion(report, profile, "renderer", "max_compat", &block->maxCompat);
+        }
+    }
+
+    /* values of a multi-valued limit are separated by spaces */
+    if (sections->limits)
+    {
+        for (idx = 0; idx < ogliLimitCount(); idx++)
+        {
+            limit = &block->limits[idx];
+            for (value = 0, used = 0; value < limit->count; value++)
+                used += snprintf(text + used, sizeof(text) - used, "%s%lld", value ? " " : "", (long long) limit->values[value]);
+            if (limit->count)
+                reportCsvString(report, profile, "limit", ogliLimitName(idx), text);
+        }
+    }
+
+    if (sections->raster)
+    {
+        reportCsvNumber(report, profile, "raster", "fill_opaque", "%.1f", job->raster.fillOpaque);
+        reportCsvNumber(report, profile, "raster", "fill_blended", "%.1f", job->raster.fillBlended);
+        reportCsvNumber(report, profile, "raster", "tris_small", "%.3f", job->raster.trisSmall);
+        reportCsvNumber(report, profile, "raster", "tris_large", "%.3f", job->raster.trisLarge);
+    }
+
+    if (sections->shaders)
+        reportCsvShaders(report, profile, &job->shaders);
+
+    if (sections->churn)
+        reportCsvChurn(report, profile, &job->churn);
+
+    /* one row per supported pair, named "format target" */
+    if (sections->formats)
+    {
+        reportCsvString(report, profile, "formats", "source", ogliFormatSourceName(ctx->iblock.formatSource));
+        for (idx = 0; idx < ogliFormatCount(); idx++)
+        {
+            if (!ctx->iblock.formats[idx].flags)
+                continue;
+            reportCsvFormat(report, profile, idx, &ctx->iblock.formats[idx]);
+        }
+    }
+
+    /* one row per config, attributes as in the text table */
+    if (sections->fbconfigs)
+    {
+        for (idx = 0; idx < ctx->totalFBConfigs; idx++)
+        {
+            config = &ctx->fbconfigs[idx];
+            snprintf(text, sizeof(text), "visual=%d rgba=%d/%d/%d/%d depth=%d stencil=%d samples=%d db=%d stereo=%d srgb=%d drawables=%c%c%c caveat=%s",
+                     config->visualId, config->red, config->green, config->blue, config->alpha,
+                     config->depth, config->stencil, config->samples, 
+                     config->doubleBuffer != 0, config->stereo != 0, config->sRGB != 0,
+                     config->drawables & OGLI_FBCONFIG_WINDOW  ? 'W' : '.',
+                     config->drawables & OGLI_FBCONFIG_PIXMAP  ? 'X' : '.',
+                     config->drawables & OGLI_FBCONFIG_PBUFFER ? 'P' : '.',
+                     reportCaveats[config->caveat]);
+            reportPrintf(report, "%s,fbconfig,%d,%s\n", profile, config->id, text);
+        }
+    }
+
+    if (sections->timings)
+    {
+        timing = ogliGetTimings(ctx);
+        for (idx = 0; idx < OGLI_TOTAL_PHASES; idx++)
+            if (timing[idx].count)
+                reportCsvNumber(report, profile, "timing_ms", ogliPhaseName((OGLI_PHASE) idx), "%.3f", timing[idx].duration * 1e3);
+    }
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+GLboolean reportRender(GLINFO_REPORT * report, GLINFO_FORMAT format, const GLINFO_SECTIONS * sections,
+                       const GLINFO_JOB * jobs, GLuint count, GLboolean profiles)
+{
+    char   label[128];
+    GLuint idx;
+
+    report->used = 0;
+    report->failed = GL_FALSE;
+    report->size = reportEstimate(jobs, count);
+    report->data = (char *) malloc(report->size);
+    if (!report->data)
+    {
+        report->size = 0;
+        return GL_FALSE;
+    }
+    report->data[0] = 0;
+
+    if (format == GLINFO_FORMAT_CSV)
+        reportPrintf(report, "profile,section,name,value\n");
+    if (format == GLINFO_FORMAT_JSON && profiles)
+        reportPrintf(report, "[");
+
+    for (idx = 0; idx < count; idx++)
+    {
+        switch (format)
+        {
+            case GLINFO_FORMAT_JSON:
+                reportPrintf(report, "%s", idx ? ",\n" : "");
+                reportJson(report, sections, &jobs[idx]);
+                break;
+            case GLINFO_FORMAT_CSV:
+                reportCsv(report, sections, &jobs[idx]);
+                break;
+            default:
+                if (profiles && jobs[idx].display)
+                {
+                    reportLabel(label, sizeof(label), &jobs[idx], " profile on ");
+                    reportPrintf(report, "%s=== %s ===\n", idx ? "\n" : "", label);
+                }
+                else if (profiles)
+                    reportPrintf(report, "%s=== %s profile ===\n", idx ? "\n" : "", ogliProfileName(jobs[idx].ctx->profile));
+                if (jobs[idx].error)
+                    reportPrintf(report, "Not available: %s\n", jobs[idx].error);
+                else
+                    reportText(report, sections, &jobs[idx]);
+        }
+    }
+
+    if (format == GLINFO_FORMAT_JSON)
+        reportPrintf(report, profiles ? "]\n" : "\n");
+    return !report->failed;
+}
+
+/* a single write unless the descriptor takes the report in pieces (pipes, sockets) */
+GLboolean reportWrite(const GLINFO_REPORT * report, int fd)
+{
+    const char  * data = report->data;
+    size_t      left = report->used;
+    int         done;
+
+    while (left)
+    {
+        done = (int) write(fd, data, (unsigned) left);
+        if (done < 0 && errno == EINTR)
+            continue;
+        if (done <= 0)
+            return GL_FALSE;
+        data += done;
+        left -= done;
+    }
+    return GL_TRUE;
+}
+
+void reportFree(GLINFO_REPORT * report)
+{
+    free(report->data);
+    report->data = NULL;
+    report->used = report->size = 0;
+}
@@ -0,0 +1,82 @@
+/* OpenGL Information Query Utility - Reports
+**
+** Copyrights (c) 2021-2023 by Trinh D.D. Nguyen <dzutrinh[]yahoo.com>
+** All Rights Reserved
+** 
+** Redistribution and use in source and binary forms, with or without 
+** modification, are permitted provided that the following conditions are met:
+** 
+** * Redistributions of source code must retain the above copyright notice, 
+**   this list of conditions and the following disclaimer.
+** * Redistributions in binary form must reproduce the above copyright notice, 
+**   this list of conditions and the following disclaimer in the documentation 
+**   and/or other materials provided with the distribution.
+** * The name of the author may be used to endorse or promote products 
+**   derived from this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE 
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF 
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+** THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef _GLINFO_REPORT_
+#define _GLINFO_REPORT_    1
+
+#include "ogli.h"
+#include "bench.h"
+
+/* output formats selected by --format */
+typedef enum {GLINFO_FORMAT_TEXT, GLINFO_FORMAT_JSON, GLINFO_FORMAT_CSV} GLINFO_FORMAT;
+
+/* one query pipeline run, possibly on its own thread */
+typedef struct probe_job
+{
+    OGLI_CONTEXT    * ctx;
+    const char      * error;        /* NULL on success */
+    GLINFO_RASTER_BENCH raster;     /* filled by --bench raster */
+    GLINFO_SHADER_BENCH shaders;    /* filled by --bench shaders */
+    GLINFO_CHURN_BENCH  churn;      /* filled by --bench churn */
+    const char      * display;      /* X display of --displays, NULL for a plain run */
+    GLint           screen;         /* screen of the display, -1 for its default screen */
+} GLINFO_JOB;
+
+/* sections of a report */
+typedef struct report_sections
+{
+    GLboolean   info;               /* strings and versions */
+    GLboolean   glu;                /* GLU version along with the strings */
+    GLboolean   renderer;           /* results of ogliQueryRenderer() */
+    GLboolean   extensions;
+    GLboolean   limits;
+    GLboolean   maxVersion;         /* results of ogliDiscoverVersions() */
+    GLboolean   raster;
+    GLboolean   shaders;
+    GLboolean   churn;
+    GLboolean   fbconfigs;
+    GLboolean   formats;            /* results of ogliQueryFormats() */
+    GLboolean   timings;
+} GLINFO_SECTIONS;
+
+/* Report rendered in memory, written at once */
+typedef struct report
+{
+    char        * data;
+    size_t      used;
+    size_t      size;
+    GLboolean   failed;             /* out of memory, the report is truncated */
+} GLINFO_REPORT;
+
+GLboolean   reportRender(GLINFO_REPORT * report, GLINFO_FORMAT format, const GLINFO_SECTIONS * sections,
+                         const GLINFO_JOB * jobs, GLuint count, GLboolean profiles);
+GLboolean   reportWrite(const GLINFO_REPORT * report, int fd);
+void        reportFree(GLINFO_REPORT * report);
+
+#endif
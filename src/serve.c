@@ -0,0 +1,493 @@
+/* OpenGL Information Query Utility - Query daemon
+**
+** Copyrights (c) 2021-2023 by Trinh D.D. Nguyen <dzutrinh[]yahoo.com>
+** All Rights Reserved
+** 
+** Redistribution and use in source and binary forms, with or without 
+** modification, are permitted provided that the following conditions are met:
+** 
+** * Redistributions of source code must retain the above copyright notice, 
+**   this list of conditions and the following disclaimer.
+** * Redistributions in binary form must reproduce the above copyright notice, 
+**   this list of conditions and the following disclaimer in the documentation 
+**   and/or other materials provided with the distribution.
+** * The name of the author may be used to endorse or promote products 
+**   derived from this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE 
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF 
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+** THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifdef __linux__
+#   define _GNU_SOURCE     /* accept4() */
+#endif
+
+#include <stdio.h>
+#include "serve.h"
+
+#ifdef __linux__
+
+#include <errno.h>
+#include <signal.h>
+#include <stdint.h>
+#include <arpa/inet.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+
+#define SERVE_MAX_EVENTS    (64)
+#define SERVE_MAX_PENDING   (256 * 1024)    /* buffered responses before a client is read again */
+
+/* one connected client, requests and responses are buffered for non-blocking I/O */
+typedef struct serve_client
+{
+    int         fd;
+    GLboolean   writing;        /* waiting for EPOLLOUT instead of EPOLLIN */
+    size_t      inUsed;
+    char        in[4 + GLINFO_SERVE_MAX_REQUEST];
+    char        * out;
+    size_t      outUsed;
+    size_t      outSent;
+    size_t      outSize;
+} SERVE_CLIENT;
+
+/* data shared by every client */
+typedef struct serve_state
+{
+    const GLINFO_JOB    * job;
+    GLINFO_SECTIONS     sections;
+    GLINFO_REPORT       reports[3];     /* indexed by GLINFO_FORMAT, rendered on first request */
+    int                 epoll;
+} SERVE_STATE;
+
+static const char * serveFormats[] = {"text", "json", "csv"};
+
+static volatile sig_atomic_t serveStop = 0;
+
+static void serveSignal(int sig)
+{
+    (void) sig;
+    serveStop = 1;
+}
+
+static GLboolean serveReserve(SERVE_CLIENT * client, size_t extra)
+{
+    char    * out;
+    size_t  size;
+
+    if (client->outUsed + extra <= client->outSize)
+        return GL_TRUE;
+
+    size = client->outSize ? client->outSize : 1024;
+    while (size < client->outUsed + extra)
+        size *= 2;
+    out = (char *) realloc(client->out, size);
+    if (!out)
+        return GL_FALSE;
+    client->out = out;
+    client->outSize = size;
+    return GL_TRUE;
+}
+
+/* queues a framed response made of a status and a body */
+static GLboolean serveRespond(SERVE_CLIENT * client, const char * status, const char * body, size_t length)
+{
+    size_t      head = strlen(status);
+    uint32_t    size = htonl((uint32_t) (head + length));
+
+    if (!serveReserve(client, 4 + head + length))
+        return GL_FALSE;
+    memcpy(client->out + client->outUsed, &size, 4);
+    memcpy(client->out + client->outUsed + 4, status, head);
+    memcpy(client->out + client->outUsed + 4 + head, body, length);
+    client->outUsed += 4 + head + length;
+    return GL_TRUE;
+}
+
+static GLboolean serveText(SERVE_CLIENT * client, const char * status, const char * body)
+{
+    return serveRespond(client, status, body, strlen(body));
+}
+
+/* one flag per name, the flags take at most as much room as the names */
+static GLboolean serveExtensions(SERVE_STATE * state, SERVE_CLIENT * client, char * names)
+{
+    char    flags[GLINFO_SERVE_MAX_REQUEST];
+    char    * name, * next;
+    size_t  used = 0;
+
+    for (name = strtok_r(names, " ", &next); name; name = strtok_r(NULL, " ", &next))
+    {
+        if (used)
+            flags[used++] = ' ';
+        flags[used++] = ogliSupported(state->job->ctx, name) ? '1' : '0';
+    }
+    if (!used)
+        return serveText(client, "ERR ", "missing extension name");
+    return serveRespond(client, "OK ", flags, used);
+}
+
+static GLboolean serveLimit(SERVE_STATE * state, SERVE_CLIENT * client, const char * name)
+{
+    const OGLI_LIMIT    * limit = name ? ogliGetLimit(state->job->ctx, name) : NULL;
+    char                values[OGLI_MAX_LIMIT_VALUES * 24];
+    size_t              used = 0;
+    GLuint              idx;
+
+    if (!limit)
+        return serveText(client, "ERR ", "unknown or unavailable limit");
+    for (idx = 0; idx < limit->count; idx++)
+        used += snprintf(values + used, sizeof(values) - used, "%s%lld", idx ? " " : "", (long long) limit->values[idx]);
+    return serveRespond(client, "OK ", values, used);
+}
+
+static GLboolean serveReport(SERVE_STATE * state, SERVE_CLIENT * client, const char * name)
+{
+    GLINFO_REPORT   * report;
+    GLuint          format;
+
+    for (format = 0; name && format < 3; format++)
+        if (strcmp(name, serveFormats[format]) == 0)
+            break;
+    if (!name)
+        format = GLINFO_FORMAT_TEXT;
+    if (format == 3)
+        return serveText(client, "ERR ", "unknown report format");
+
+    report = &state->reports[format];
+    if (!report->data && !reportRender(report, (GLINFO_FORMAT) format, &state->sections, state->job, 1, GL_FALSE))
+    {
+        reportFree(report);
+        return serveText(client, "ERR ", "not enough memory");
+    }
+    return serveRespond(client, "OK ", report->data, report->used);
+}
+
+static GLboolean serveRequest(SERVE_STATE * state, SERVE_CLIENT * client, const char * data, size_t length)
+{
+    char    request[GLINFO_SERVE_MAX_REQUEST + 1];
+    char    * verb, * next;
+
+    memcpy(request, data, length);
+    request[length] = 0;
+
+    verb = strtok_r(request, " ", &next);
+    if (!verb)
+        return serveText(client, "ERR ", "empty request");
+    if (strcmp(verb, "ping") == 0)
+        return serveText(client, "OK ", "pong");
+    if (strcmp(verb, "ext") == 0)
+        return serveExtensions(state, client, next);
+    if (strcmp(verb, "limit") == 0)
+        return serveLimit(state, client, strtok_r(NULL, " ", &next));
+    if (strcmp(verb, "report") == 0)
+        return serveReport(state, client, strtok_r(NULL, " ", &next));
+    return serveText(client, "ERR ", "unknown request");
+}
+
+/* answers the complete requests in the input buffer, leaves the rest for later */
+static GLboolean serveProcess(SERVE_STATE * state, SERVE_CLIENT * client)
+{
+    uint32_t    length;
+    size_t      done = 0;
+
+    while (client->inUsed - done >= 4 && client->outUsed - client->outSent < SERVE_MAX_PENDING)
+    {
+        memcpy(&length, client->in + done, 4);
+        length = ntohl(length);
+        if (length > GLINFO_SERVE_MAX_REQUEST)
+            return GL_FALSE;
+        if (client->inUsed - done < 4 + length)
+            break;
+        if (!serveRequest(state, client, client->in + done + 4, length))
+            return GL_FALSE;
+        done += 4 + length;
+    }
+    memmove(client->in, client->in + done, client->inUsed - done);
+    client->inUsed -= done;
+    return GL_TRUE;
+}
+
+/* sends what the socket takes, then waits for the rest or for new requests */
+static GLboolean serveFlush(SERVE_STATE * state, SERVE_CLIENT * client)
+{
+    struct epoll_event  event;
+    ssize_t             sent;
+    GLboolean           writing;
+
+    while (client->outSent < client->outUsed)
+    {
+        sent = send(client->fd, client->out + client->outSent, client->outUsed - client->outSent, MSG_NOSIGNAL);
+        if (sent < 0 && errno == EINTR)
+            continue;
+        if (sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+            break;
+        if (sent <= 0)
+            return GL_FALSE;
+        client->outSent += sent;
+    }
+    if (client->outSent == client->outUsed)
+        client->outSent = client->outUsed = 0;
+
+    /* a client with pending responses is not read, which bounds its buffers */
+    writing = client->outUsed != 0;
+    if (writing != client->writing)
+    {
+        event.events = writing ? EPOLLOUT : EPOLLIN;
+        event.data.ptr = client;
+        if (epoll_ctl(state->epoll, EPOLL_CTL_MOD, client->fd, &event) < 0)
+            return GL_FALSE;
+        client->writing = writing;
+    }
+    return GL_TRUE;
+}
+
+static GLboolean serveRead(SERVE_STATE * state, SERVE_CLIENT * client)
+{
+    ssize_t received;
+
+    while (client->inUsed < sizeof(client->in))
+    {
+        received = recv(client->fd, client->in + client->inUsed, sizeof(client->in) - client->inUsed, 0);
+        if (received < 0 && errno == EINTR)
+            continue;
+        if (received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+            break;
+        if (received <= 0)
+            return GL_FALSE;
+        client->inUsed += received;
+        if (!serveProcess(state, client))
+            return GL_FALSE;
+        if (client->outUsed)
+            break;
+    }
+    return serveFlush(state, client);
+}
+
+static void serveClose(SERVE_STATE * state, SERVE_CLIENT * client)
+{
+    epoll_ctl(state->epoll, EPOLL_CTL_DEL, client->fd, NULL);
+    close(client->fd);
+    free(client->out);
+    free(client);
+}
+
+static void serveAccept(SERVE_STATE * state, int listener)
+{
+    struct epoll_event  event;
+    SERVE_CLIENT        * client;
+    int                 fd;
+
+    while ((fd = accept4(listener, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC)) >= 0)
+    {
+        client = (SERVE_CLIENT *) calloc(1, sizeof(SERVE_CLIENT));
+        event.events = EPOLLIN;
+        event.data.ptr = client;
+        if (!client || epoll_ctl(state->epoll, EPOLL_CTL_ADD, fd, &event) < 0)
+        {
+            free(client);
+            close(fd);
+            continue;
+        }
+        client->fd = fd;
+    }
+}
+
+static int serveListen(const char * path)
+{
+    struct sockaddr_un  addr;
+    struct stat         info;
+    int                 fd;
+
+    if (strlen(path) >= sizeof(addr.sun_path))
+    {
+        fprintf(stderr, "ERROR: Socket path is too long.\n");
+        return -1;
+    }
+
+    /* a socket left by a previous instance is replaced, anything else is kept */
+    if (lstat(path, &info) == 0 && S_ISSOCK(info.st_mode))
+        unlink(path);
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strcpy(addr.sun_path, path);
+
+    fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0 || bind(fd, (struct sockaddr *) &addr, sizeof(addr)) < 0 || listen(fd, SOMAXCONN) < 0)
+    {
+        fprintf(stderr, "ERROR: Unable to listen on %s: %s\n", path, strerror(errno));
+        if (fd >= 0)
+            close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+int serveRun(const char * path, const GLINFO_JOB * job, const GLINFO_SECTIONS * sections)
+{
+    struct epoll_event  event, events[SERVE_MAX_EVENTS];
+    struct sigaction    action;
+    SERVE_STATE         state;
+    SERVE_CLIENT        * client;
+    GLboolean           alive;
+    int                 listener, count, idx;
+
+    memset(&state, 0, sizeof(state));
+    state.job = job;
+    state.sections = *sections;
+
+    listener = serveListen(path);
+    if (listener < 0)
+        return -1;
+
+    state.epoll = epoll_create1(EPOLL_CLOEXEC);
+    event.events = EPOLLIN;
+    event.data.ptr = NULL;
+    if (state.epoll < 0 || epoll_ctl(state.epoll, EPOLL_CTL_ADD, listener, &event) < 0)
+    {
+        fprintf(stderr, "ERROR: Unable to poll %s: %s\n", path, strerror(errno));
+        close(listener);
+        unlink(path);
+        return -1;
+    }
+
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = serveSignal;
+    sigaction(SIGINT, &action, NULL);
+    sigaction(SIGTERM, &action, NULL);
+    signal(SIGPIPE, SIG_IGN);
+
+    while (!serveStop)
+    {
+        count = epoll_wait(state.epoll, events, SERVE_MAX_EVENTS, -1);
+        if (count < 0 && errno != EINTR)
+            break;
+        for (idx = 0; idx < count; idx++)
+        {
+            client = (SERVE_CLIENT *) events[idx].data.ptr;
+            if (!client)
+            {
+                serveAccept(&state, listener);
+                continue;
+            }
+
+            if (events[idx].events & (EPOLLERR | EPOLLHUP) && !(events[idx].events & EPOLLIN))
+                alive = GL_FALSE;
+            else if (client->writing)
+                alive = serveFlush(&state, client) && (client->writing || (serveProcess(&state, client) && serveFlush(&state, client)));
+            else
+                alive = serveRead(&state, client);
+            if (!alive)
+                serveClose(&state, client);
+        }
+    }
+
+    /* clients still connected are released by the exit */
+    close(state.epoll);
+    close(listener);
+    unlink(path);
+    for (idx = 0; idx < 3; idx++)
+        reportFree(&state.reports[idx]);
+    return 0;
+}
+
+static GLboolean serveTransfer(int fd, char * data, size_t length, GLboolean sending)
+{
+    ssize_t done;
+
+    while (length)
+    {
+        done = sending ? send(fd, data, length, MSG_NOSIGNAL) : recv(fd, data, length, 0);
+        if (done < 0 && errno == EINTR)
+            continue;
+        if (done <= 0)
+            return GL_FALSE;
+        data += done;
+        length -= done;
+    }
+    return GL_TRUE;
+}
+
+/* sends one request and prints the answer, the exit status tells whether it was OK */
+int serveQuery(const char * path, const char * request)
+{
+    struct sockaddr_un  addr;
+    size_t              length = strlen(request);
+    uint32_t            size = htonl((uint32_t) length);
+    char                * answer;
+    int                 fd, status = -1;
+
+    if (strlen(path) >= sizeof(addr.sun_path) || length > GLINFO_SERVE_MAX_REQUEST)
+    {
+        fprintf(stderr, "ERROR: Socket path or request is too long.\n");
+        return -1;
+    }
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strcpy(addr.sun_path, path);
+
+    fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0 || connect(fd, (struct sockaddr *) &addr, sizeof(addr)) < 0)
+    {
+        fprintf(stderr, "ERROR: Unable to connect to %s: %s\n", path, strerror(errno));
+        if (fd >= 0)
+            close(fd);
+        return -1;
+    }
+
+    if (serveTransfer(fd, (char *) &size, 4, GL_TRUE) && serveTransfer(fd, (char *) request, length, GL_TRUE) &&
+        serveTransfer(fd, (char *) &size, 4, GL_FALSE))
+    {
+        length = ntohl(size);
+        answer = (char *) malloc(length + 1);
+        if (answer && serveTransfer(fd, answer, length, GL_FALSE))
+        {
+            answer[length] = 0;
+            if (strncmp(answer, "OK ", 3) == 0)
+            {
+                fwrite(answer + 3, 1, length - 3, stdout);
+                if (length > 3 && answer[length - 1] != '\n')
+                    fputc('\n', stdout);
+                status = 0;
+            }
+            else
+                fprintf(stderr, "ERROR: %s\n", strncmp(answer, "ERR ", 4) == 0 ? answer + 4 : answer);
+        }
+        else
+            fprintf(stderr, "ERROR: Truncated answer from %s.\n", path);
+        free(answer);
+    }
+    else
+        fprintf(stderr, "ERROR: No answer from %s.\n", path);
+
+    close(fd);
+    return status;
+}
+
+#else
+
+int serveRun(const char * path, const GLINFO_JOB * job, const GLINFO_SECTIONS * sections)
+{
+    fprintf(stderr, "ERROR: Query daemon is only available on Linux.\n");
+    return -1;
+}
+
+int serveQuery(const char * path, const char * request)
+{
+    fprintf(stderr, "ERROR: Query daemon is only available on Linux.\n");
+    return -1;
+}
+
+#endif
@@ -0,0 +1,54 @@
+/* OpenGL Information Query Utility - Query daemon
+**
+** Copyrights (c) 2021-2023 by Trinh D.D. Nguyen <dzutrinh[]yahoo.com>
+** All Rights Reserved
+** 
+** Redistribution and use in source and binary forms, with or without 
+** modification, are permitted provided that the following conditions are met:
+** 
+** * Redistributions of source code must retain the above copyright notice, 
+**   this list of conditions and the following disclaimer.
+** * Redistributions in binary form must reproduce the above copyright notice, 
+**   this list of conditions and the following disclaimer in the documentation 
+**   and/or other materials provided with the distribution.
+** * The name of the author may be used to endorse or promote products 
+**   derived from this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE 
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF 
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+** THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef _GLINFO_SERVE_
+#define _GLINFO_SERVE_    1
+
+#include "report.h"
+
+/*
+** Wire protocol of --serve, on a Unix stream socket:
+**
+**  every message is a 4 bytes length in network byte order followed by that many bytes,
+**  a request is a line of space separated words, the response starts with "OK " or "ERR ".
+**
+**  ping                    OK pong
+**  ext NAME [NAME...]      OK 1 0 ...      one flag per extension name
+**  limit NAME              OK 16384        values of a multi-valued limit are space separated
+**  report [text|json|csv]  OK <report>     info, extensions and limits, rendered once per format
+**
+** Requests are answered in order, a client may pipeline them.
+*/
+
+#define GLINFO_SERVE_MAX_REQUEST    (4096)      /* longest request, larger ones drop the client */
+
+int serveRun(const char * path, const GLINFO_JOB * job, const GLINFO_SECTIONS * sections);
+int serveQuery(const char * path, const char * request);
+
+#endif
@@ -0,0 +1,308 @@
+/* OpenGL Information Query Utility - GPU monitor
+**
+** Copyrights (c) 2021-2023 by Trinh D.D. Nguyen <dzutrinh[]yahoo.com>
+** All Rights Reserved
+** 
+** Redistribution and use in source and binary forms, with or without 
+** modification, are permitted provided that the following conditions are met:
+** 
+** * Redistributions of source code must retain the above copyright notice, 
+**   this list of conditions and the following disclaimer.
+** * Redistributions in binary form must reproduce the above copyright notice, 
+**   this list of conditions and the following disclaimer in the documentation 
+**   and/or other materials provided with the distribution.
+** * The name of the author may be used to endorse or promote products 
+**   derived from this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE 
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF 
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+** THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <errno.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#ifndef _WIN32
+#   include <time.h>
+#endif
+#include "watch.h"
+
+/* tokens of GL_NVX_gpu_memory_info and GL_ATI_meminfo */
+#define GL_GPU_MEMORY_INFO_DEDICATED_VIDMEM_NVX         0x9047
+#define GL_GPU_MEMORY_INFO_CURRENT_AVAILABLE_VIDMEM_NVX 0x9049
+#define GL_GPU_MEMORY_INFO_EVICTION_COUNT_NVX           0x904A
+#define GL_GPU_MEMORY_INFO_EVICTED_MEMORY_NVX           0x904B
+#define GL_VBO_FREE_MEMORY_ATI                          0x87FB
+#define GL_TEXTURE_FREE_MEMORY_ATI                      0x87FC
+#define GL_RENDERBUFFER_FREE_MEMORY_ATI                 0x87FD
+
+#define WATCH_CALIBRATE     (600.0)     /* seconds between two alignments of the GPU clock */
+
+static const char * watchSources[] = {"nvx", "ati", "mesa", "heartbeat"};
+
+/* everything the loop needs, nothing is allocated once it runs */
+typedef struct watch_state
+{
+    OGLI_CONTEXT        * ctx;
+    GLINFO_WATCH_SOURCE source;
+    OGLI_TIMER          * timer;        /* heartbeats, NULL with live memory counters */
+    double              calibrated;     /* ogliNow() of the last ogliTimerCalibrate() */
+    double              latency;        /* of the last heartbeat read, negative until one is */
+    GLINFO_WATCH_SAMPLE ring[GLINFO_WATCH_RING];
+    GLuint              first;          /* oldest sample not written yet */
+    GLuint              count;          /* samples not written yet */
+    double              since;          /* ogliNow() of the oldest sample not written yet */
+    GLuint              dropped;        /* overwritten since the last sample taken */
+    char                out[GLINFO_WATCH_BATCH * GLINFO_WATCH_LINE];
+} WATCH_STATE;
+
+static volatile sig_atomic_t watchStop = 0;
+
+static void watchSignal(int sig)
+{
+    (void) sig;
+    watchStop = 1;
+}
+
+/* Unix time in seconds, the samples are meant to be matched with other logs */
+static double watchClock()
+{
+#ifdef _WIN32
+    FILETIME            ft;
+    unsigned __int64    ticks;
+
+    GetSystemTimeAsFileTime(&ft);
+    ticks = ((unsigned __int64) ft.dwHighDateTime << 32) | ft.dwLowDateTime;
+    return (double) (ticks - 116444736000000000ULL) * 1e-7;
+#else
+    struct timespec ts;
+
+    clock_gettime(CLOCK_REALTIME, &ts);
+    return (double) ts.tv_sec + (double) ts.tv_nsec * 1e-9;
+#endif
+}
+
+static void watchSleep(double seconds)
+{
+#ifdef _WIN32
+    Sleep((DWORD) (seconds * 1000.0));
+#else
+    struct timespec ts;
+
+    ts.tv_sec = (time_t) seconds;
+    ts.tv_nsec = (long) ((seconds - (double) ts.tv_sec) * 1e9);
+    nanosleep(&ts, NULL);           /* a signal cuts it short, the loop checks for it */
+#endif
+}
+
+/* reads the heartbeats the GPU went through, then submits a new one without waiting */
+static void watchHeartbeat(WATCH_STATE * state, GLINFO_WATCH_SAMPLE * sample)
+{
+    OGLI_TIMER  * timer = state->timer;
+    double      submitted, start;
+
+    for (;;)
+    {
+        submitted = timer->submitted[(timer->read % OGLI_TIMER_RING) * 2];
+        if (!ogliTimerRead(timer, &start, NULL))
+            break;
+        /* only GL_TIMESTAMP tells when the GPU started on it */
+        if (timer->mode == OGLI_TIMER_TIMESTAMP)
+            state->latency = start - submitted;
+    }
+
+    sample->pending = (GLint) (timer->issued - timer->read);
+    sample->latency = state->latency;
+
+    /* a full ring means the GPU is stuck, pending then stays at its size */
+    if (ogliTimerBegin(timer))
+    {
+        ogliTimerEnd(timer);
+        glFlush();
+    }
+}
+
+static void watchSample(WATCH_STATE * state, GLINFO_WATCH_SAMPLE * sample)
+{
+    sample->time = watchClock();
+    sample->totalKB = sample->availableKB = sample->evictions = sample->evictedKB = -1;
+    sample->bufferKB = sample->renderbufferKB = sample->pending = -1;
+    sample->latency = -1;
+    sample->dropped = state->dropped;
+    state->dropped = 0;
+
+    switch (state->source)
+    {
+        case GLINFO_WATCH_NVX:
+            glGetIntegerv(GL_GPU_MEMORY_INFO_DEDICATED_VIDMEM_NVX, &sample->totalKB);
+            glGetIntegerv(GL_GPU_MEMORY_INFO_CURRENT_AVAILABLE_VIDMEM_NVX, &sample->availableKB);
+            glGetIntegerv(GL_GPU_MEMORY_INFO_EVICTION_COUNT_NVX, &sample->evictions);
+            glGetIntegerv(GL_GPU_MEMORY_INFO_EVICTED_MEMORY_NVX, &sample->evictedKB);
+            break;
+
+        case GLINFO_WATCH_ATI:
+        {
+            GLint pool[4];          /* total free, largest block, auxiliary free, largest auxiliary block */
+
+            glGetIntegerv(GL_TEXTURE_FREE_MEMORY_ATI, pool);
+            sample->availableKB = pool[0];
+            glGetIntegerv(GL_VBO_FREE_MEMORY_ATI, pool);
+            sample->bufferKB = pool[0];
+            glGetIntegerv(GL_RENDERBUFFER_FREE_MEMORY_ATI, pool);
+            sample->renderbufferKB = pool[0];
+            break;
+        }
+
+        case GLINFO_WATCH_MESA:
+            /* the renderer only tells the size, the heartbeat shows the GPU is still moving */
+            sample->totalKB = (GLint) state->ctx->iblock.renderer.videoMemory * 1024;
+            watchHeartbeat(state, sample);
+            break;
+
+        default:
+            watchHeartbeat(state, sample);
+    }
+}
+
+static size_t watchFormat(const GLINFO_WATCH_SAMPLE * sample, GLINFO_WATCH_SOURCE source, char * line)
+{
+    int used;
+
+    used = snprintf(line, GLINFO_WATCH_LINE, "{\"time\":%.3f,\"source\":\"%s\"", sample->time, watchSources[source]);
+    if (sample->totalKB >= 0)
+        used += snprintf(line + used, GLINFO_WATCH_LINE - used, ",\"totalKB\":%d", sample->totalKB);
+    if (sample->availableKB >= 0)
+        used += snprintf(line + used, GLINFO_WATCH_LINE - used, ",\"availableKB\":%d", sample->availableKB);
+    if (sample->evictions >= 0)
+        used += snprintf(line + used, GLINFO_WATCH_LINE - used, ",\"evictions\":%d,\"evictedKB\":%d",
+                         sample->evictions, sample->evictedKB);
+    if (sample->bufferKB >= 0)
+        used += snprintf(line + used, GLINFO_WATCH_LINE - used, ",\"bufferKB\":%d,\"renderbufferKB\":%d",
+                         sample->bufferKB, sample->renderbufferKB);
+    if (sample->pending >= 0)
+        used += snprintf(line + used, GLINFO_WATCH_LINE - used, ",\"pending\":%d", sample->pending);
+    if (sample->latency >= 0)
+        used += snprintf(line + used, GLINFO_WATCH_LINE - used, ",\"latencyMs\":%.3f", sample->latency * 1e3);
+    if (sample->dropped)
+        used += snprintf(line + used, GLINFO_WATCH_LINE - used, ",\"dropped\":%u", sample->dropped);
+    used += snprintf(line + used, GLINFO_WATCH_LINE - used, "}\n");
+    return (size_t) used;
+}
+
+/* writes up to a batch of the oldest samples, they stay in the ring when the output fails */
+static GLboolean watchFlush(WATCH_STATE * state)
+{
+    GLINFO_REPORT   batch;
+    GLuint          idx, count;
+
+    count = state->count < GLINFO_WATCH_BATCH ? state->count : GLINFO_WATCH_BATCH;
+    batch.data = state->out;
+    batch.size = sizeof(state->out);
+    batch.used = 0;
+    batch.failed = GL_FALSE;
+    for (idx = 0; idx < count; idx++)
+        batch.used += watchFormat(&state->ring[(state->first + idx) % GLINFO_WATCH_RING],
+                                  state->source, state->out + batch.used);
+    if (!reportWrite(&batch, 1))
+        return GL_FALSE;
+
+    state->first = (state->first + count) % GLINFO_WATCH_RING;
+    state->count -= count;
+    state->since = ogliNow();
+    return GL_TRUE;
+}
+
+int watchRun(OGLI_CONTEXT * ctx, double interval)
+{
+    WATCH_STATE     * state;
+    double          next, now;
+    GLuint          slot;
+
+    state = (WATCH_STATE *) calloc(1, sizeof(WATCH_STATE));
+    if (!state)
+    {
+        fprintf(stderr, "ERROR: Not enough memory.\n");
+        return -1;
+    }
+    state->ctx = ctx;
+    state->latency = -1;
+
+    if (ogliSupported(ctx, "GL_NVX_gpu_memory_info"))
+        state->source = GLINFO_WATCH_NVX;
+    else if (ogliSupported(ctx, "GL_ATI_meminfo"))
+        state->source = GLINFO_WATCH_ATI;
+    else if (ogliQueryRenderer(ctx) && ctx->iblock.renderer.videoMemory)
+        state->source = GLINFO_WATCH_MESA;
+    else
+        state->source = GLINFO_WATCH_HEARTBEAT;
+
+    if (state->source >= GLINFO_WATCH_MESA)
+    {
+        state->timer = ogliTimerCreate(ctx);
+        if (!state->timer || !ogliTimerCalibrate(state->timer))
+        {
+            fprintf(stderr, "ERROR: Unable to create a GPU timer.\n");
+            ogliTimerDestroy(state->timer);
+            free(state);
+            return -1;
+        }
+        state->calibrated = ogliNow();
+    }
+
+    fprintf(stderr, "Watching %s every %.3f s through %s, interrupt to stop.\n",
+            ctx->iblock.glRenderer, interval, watchSources[state->source]);
+
+    signal(SIGINT, watchSignal);
+    signal(SIGTERM, watchSignal);
+
+    next = ogliNow();
+    while (!watchStop)
+    {
+        /* the oldest sample makes room when the output cannot keep up */
+        if (state->count == GLINFO_WATCH_RING)
+        {
+            state->first = (state->first + 1) % GLINFO_WATCH_RING;
+            state->count--;
+            state->dropped++;
+        }
+        slot = (state->first + state->count) % GLINFO_WATCH_RING;
+        watchSample(state, &state->ring[slot]);
+        if (!state->count++)
+            state->since = ogliNow();
+
+        now = ogliNow();
+        if (state->count >= GLINFO_WATCH_BATCH || now - state->since >= GLINFO_WATCH_DELAY)
+            watchFlush(state);
+        if (state->timer && now - state->calibrated >= WATCH_CALIBRATE)
+        {
+            ogliTimerCalibrate(state->timer);
+            state->calibrated = now;
+        }
+
+        /* ticks stay on the grid, a late one skips ahead instead of bursting */
+        next += interval;
+        now = ogliNow();
+        if (next < now)
+            next = now;
+        else
+            watchSleep(next - now);
+    }
+
+    while (state->count && watchFlush(state))
+        ;
+    signal(SIGINT, SIG_DFL);
+    signal(SIGTERM, SIG_DFL);
+    if (state->timer)
+        ogliTimerDestroy(state->timer);
+    free(state);
+    return 0;
+}
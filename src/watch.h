@@ -0,0 +1,70 @@
+/* OpenGL Information Query Utility - GPU monitor
+**
+** Copyrights (c) 2021-2023 by Trinh D.D. Nguyen <dzutrinh[]yahoo.com>
+** All Rights Reserved
+** 
+** Redistribution and use in source and binary forms, with or without 
+** modification, are permitted provided that the following conditions are met:
+** 
+** * Redistributions of source code must retain the above copyright notice, 
+**   this list of conditions and the following disclaimer.
+** * Redistributions in binary form must reproduce the above copyright notice, 
+**   this list of conditions and the following disclaimer in the documentation 
+**   and/or other materials provided with the distribution.
+** * The name of the author may be used to endorse or promote products 
+**   derived from this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE 
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF 
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+** THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef _GLINFO_WATCH_
+#define _GLINFO_WATCH_    1
+
+#include "report.h"
+
+/*
+** Output of --watch, one JSON object per line:
+**
+**  {"time":1700000000.250,"source":"nvx","totalKB":8388608,"availableKB":7340032,"evictions":0,"evictedKB":0}
+**  {"time":1700000001.250,"source":"heartbeat","pending":1,"latencyMs":0.041}
+**
+**  time is in Unix seconds, fields the source cannot tell are left out, "dropped" counts the
+**  samples overwritten before they could be written.
+*/
+
+#define GLINFO_WATCH_RING       (256)       /* samples kept in memory while the output is behind */
+#define GLINFO_WATCH_BATCH      (32)        /* samples written at once */
+#define GLINFO_WATCH_DELAY      (10.0)      /* seconds a sample may wait for its batch */
+#define GLINFO_WATCH_LINE       (256)       /* longest line of a sample */
+
+/* where the samples come from, the first one the driver has */
+typedef enum {GLINFO_WATCH_NVX, GLINFO_WATCH_ATI, GLINFO_WATCH_MESA, GLINFO_WATCH_HEARTBEAT} GLINFO_WATCH_SOURCE;
+
+/* one sample, -1 for what the source cannot tell */
+typedef struct watch_sample
+{
+    double      time;               /* Unix time in seconds */
+    GLint       totalKB;            /* dedicated video memory */
+    GLint       availableKB;        /* free video memory, the texture pool with GL_ATI_meminfo */
+    GLint       evictions;          /* GL_NVX_gpu_memory_info only */
+    GLint       evictedKB;
+    GLint       bufferKB;           /* free VBO and renderbuffer pools, GL_ATI_meminfo only */
+    GLint       renderbufferKB;
+    GLint       pending;            /* heartbeats the GPU has not reached yet */
+    double      latency;            /* submission to GPU start of the last heartbeat read, seconds */
+    GLuint      dropped;            /* samples lost just before this one */
+} GLINFO_WATCH_SAMPLE;
+
+int watchRun(OGLI_CONTEXT * ctx, double interval);
+
+#endif